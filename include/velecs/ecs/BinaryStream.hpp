@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace velecs::ecs {
+
+/// @class BinaryWriter
+/// @brief Appends raw values to a byte buffer.
+/// @details Used by component codecs (`void Serialize(BinaryWriter&) const`) and by the scene's
+///          cold storage. Values are written in host byte order without padding or tags.
+class BinaryWriter {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a writer appending to the given buffer.
+    /// @param buffer The buffer to append to. Must outlive the writer.
+    explicit BinaryWriter(std::vector<unsigned char>& buffer)
+        : _buffer(buffer) {}
+
+    /// @brief Deleted default constructor.
+    BinaryWriter() = delete;
+
+    /// @brief Default destructor.
+    ~BinaryWriter() = default;
+
+    // Public Methods
+
+    /// @brief Appends raw bytes.
+    /// @param data Pointer to the bytes.
+    /// @param size Number of bytes.
+    void Write(const void* const data, const size_t size);
+
+    /// @brief Appends a trivially copyable value.
+    /// @tparam T The value type.
+    /// @param value The value to append.
+    template<typename T>
+    inline void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as bytes");
+        Write(&value, sizeof(T));
+    }
+
+    /// @brief Appends a length-prefixed string.
+    /// @param value The string to append.
+    void WriteString(const std::string& value);
+
+    /// @brief Overwrites a previously written value, e.g. a length placeholder.
+    /// @tparam T The value type.
+    /// @param offset Byte offset of the value in the buffer.
+    /// @param value The new value.
+    template<typename T>
+    inline void Patch(const size_t offset, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as bytes");
+        std::memcpy(_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    /// @brief Discards everything written after the given size.
+    /// @param size Buffer size to roll back to.
+    inline void Truncate(const size_t size) { _buffer.resize(size); }
+
+    /// @brief Gets the current size of the buffer.
+    inline size_t GetSize() const { return _buffer.size(); }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<unsigned char>& _buffer; ///< @brief The buffer being appended to.
+
+    // Private Methods
+};
+
+/// @class BinaryReader
+/// @brief Reads raw values back from a byte range written by BinaryWriter.
+/// @details Reading past the end throws std::runtime_error, since it means the data is corrupt
+///          or was written by a different version of a codec.
+class BinaryReader {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a reader over a byte range.
+    /// @param data Pointer to the first byte. Must outlive the reader.
+    /// @param size Number of readable bytes.
+    BinaryReader(const unsigned char* const data, const size_t size)
+        : _data(data), _size(size) {}
+
+    /// @brief Creates a reader over a whole buffer.
+    /// @param buffer The buffer to read. Must outlive the reader.
+    explicit BinaryReader(const std::vector<unsigned char>& buffer)
+        : BinaryReader(buffer.data(), buffer.size()) {}
+
+    /// @brief Deleted default constructor.
+    BinaryReader() = delete;
+
+    /// @brief Default destructor.
+    ~BinaryReader() = default;
+
+    // Public Methods
+
+    /// @brief Reads raw bytes.
+    /// @param outData Destination for the bytes.
+    /// @param size Number of bytes to read.
+    /// @throws std::runtime_error if fewer bytes remain.
+    void Read(void* const outData, const size_t size);
+
+    /// @brief Reads a trivially copyable value.
+    /// @tparam T The value type.
+    /// @return The value.
+    /// @throws std::runtime_error if fewer than sizeof(T) bytes remain.
+    template<typename T>
+    inline T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read as bytes");
+        T value;
+        Read(&value, sizeof(T));
+        return value;
+    }
+
+    /// @brief Reads a length-prefixed string.
+    /// @throws std::runtime_error if the string runs past the end.
+    std::string ReadString();
+
+    /// @brief Skips bytes without reading them.
+    /// @param size Number of bytes to skip.
+    /// @throws std::runtime_error if fewer bytes remain.
+    void Skip(const size_t size);
+
+    /// @brief Gets the current read offset.
+    inline size_t GetPosition() const { return _position; }
+
+    /// @brief Checks whether every byte was read.
+    inline bool IsAtEnd() const { return _position >= _size; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    const unsigned char* _data{nullptr}; ///< @brief First readable byte.
+    size_t _size{0};                     ///< @brief Number of readable bytes.
+    size_t _position{0};                 ///< @brief Current read offset.
+
+    // Private Methods
+
+    /// @brief Throws if fewer than size bytes remain.
+    void Require(const size_t size) const;
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "velecs/ecs/QuerySignature.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Scene;
+
+/// @class CachedQueryBase
+/// @brief Common base letting a scene own cached queries of any signature.
+class CachedQueryBase {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    CachedQueryBase() = default;
+
+    /// @brief Default deconstructor.
+    virtual ~CachedQueryBase() = default;
+
+    // Delete copy and move operations since the registry signals point at the instance
+    CachedQueryBase(const CachedQueryBase&) = delete;
+    CachedQueryBase& operator=(const CachedQueryBase&) = delete;
+    CachedQueryBase(CachedQueryBase&&) = delete;
+    CachedQueryBase& operator=(CachedQueryBase&&) = delete;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+template<typename Signature, typename Excluded = Exclude<>>
+class CachedQuery;
+
+/// @class CachedQuery
+/// @brief Keeps the entities matching a query in a dense array across frames.
+/// @tparam Included The tags and components a match must own.
+/// @tparam Excluded The tags and components a match must not own.
+///
+/// A view re-tests every candidate against each pool on every iteration. A cached query tests
+/// an entity once, when one of the listed pools gains or loses it, and otherwise iterates a
+/// plain array of matches. Changes are collected from the pools' construct and destroy signals
+/// and applied by the next Each() or Refresh(), so adding or removing the listed types inside
+/// Each() is safe and takes effect on the following call.
+///
+/// An optional filter adds checks that are not pool membership, such as relations. It runs
+/// whenever an entity is retested; state it reads that changes without a listed pool changing
+/// must be reported with Reevaluate().
+///
+/// Create cached queries with Scene::CreateCachedQuery(), which owns them:
+/// @code
+/// auto* targets = scene->CreateCachedQuery<QuerySignature<Enemy, Visible>, Exclude<Dead>>(
+///     [scene, player](Entity* entity) { return scene->HasRelation<Targets>(entity, player); });
+/// targets->Each([](Entity* enemy) { Highlight(enemy); });
+/// @endcode
+template<typename... Included, typename... Excluded>
+class CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>> : public CachedQueryBase {
+public:
+    /// @brief Extra check an entity owning the right types must pass to match.
+    using Filter = std::function<bool(Entity*)>;
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Collects every entity currently matching and starts listening for changes.
+    /// @param scene The queried scene. Must be initialized.
+    /// @param filter Optional extra check, may be empty.
+    CachedQuery(Scene* const scene, Filter filter);
+
+    /// @brief Deleted default constructor.
+    CachedQuery() = delete;
+
+    /// @brief Stops listening for changes.
+    ~CachedQuery() override;
+
+    // Public Methods
+
+    /// @brief Calls a function on every matching entity.
+    /// @param callback Called as callback(Entity*).
+    /// @details Applies the pending changes first. The order is unspecified. The callback may
+    ///          add or remove the listed types but must not destroy other matching entities.
+    template<typename Func>
+    void Each(Func&& callback);
+
+    /// @brief Gets the matching entities, after applying the pending changes.
+    /// @return Reference valid until the next refresh.
+    const std::vector<Entity*>& GetEntities();
+
+    /// @brief Retests the entities whose listed pools changed since the last call.
+    void Refresh();
+
+    /// @brief Retests an entity on the next refresh, for changes the filter depends on.
+    /// @param entity The entity to retest.
+    void Reevaluate(const Entity* const entity);
+
+    /// @brief Retests every entity owning the included types from scratch.
+    void Rebuild();
+
+    /// @brief Gets the number of matching entities, as of the last refresh.
+    inline size_t GetCount() const { return _entities.size(); }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    Scene* const _scene; ///< @brief The queried scene.
+    Filter _filter;      ///< @brief Extra check, may be empty.
+
+    std::vector<Entity*> _entities;     ///< @brief Matching entities, as of the last refresh.
+    std::vector<entt::entity> _handles; ///< @brief Handles of the matching entities, in the same order.
+    entt::storage<size_t> _slots;       ///< @brief Index of each match in the dense arrays.
+    std::vector<entt::entity> _pending; ///< @brief Entities to retest on the next refresh.
+
+    // Private Methods
+
+    /// @brief Checks whether a live entity matches the query.
+    bool Matches(const entt::entity entity);
+
+    /// @brief Adds an entity to the dense arrays unless it is already there.
+    void Insert(const entt::entity entity);
+
+    /// @brief Removes an entity from the dense arrays by swapping in the last match.
+    void Erase(const entt::entity entity);
+
+    /// @brief Records an entity that gained or lost one of the listed types.
+    void OnChange(entt::registry& registry, const entt::entity entity);
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/CachedQuery.inl"
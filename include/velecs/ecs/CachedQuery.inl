@@ -0,0 +1,148 @@
+#include "velecs/ecs/Entity.hpp"
+#include "velecs/ecs/Scene.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace velecs::ecs {
+
+// Constructors and Destructors
+
+template<typename... Included, typename... Excluded>
+CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::CachedQuery(Scene* const scene, Filter filter)
+    : _scene(scene), _filter(std::move(filter))
+{
+    static_assert(sizeof...(Included) > 0, "A cached query must include at least one type");
+    assert(_scene && "Cached query requires a scene");
+
+    Rebuild();
+
+    entt::registry& registry = _scene->GetRegistry();
+    (registry.template on_construct<Included>().template connect<&CachedQuery::OnChange>(*this), ...);
+    (registry.template on_destroy<Included>().template connect<&CachedQuery::OnChange>(*this), ...);
+    (registry.template on_construct<Excluded>().template connect<&CachedQuery::OnChange>(*this), ...);
+    (registry.template on_destroy<Excluded>().template connect<&CachedQuery::OnChange>(*this), ...);
+}
+
+template<typename... Included, typename... Excluded>
+CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::~CachedQuery()
+{
+    entt::registry& registry = _scene->GetRegistry();
+    (registry.template on_construct<Included>().disconnect(*this), ...);
+    (registry.template on_destroy<Included>().disconnect(*this), ...);
+    (registry.template on_construct<Excluded>().disconnect(*this), ...);
+    (registry.template on_destroy<Excluded>().disconnect(*this), ...);
+}
+
+// Public Methods
+
+template<typename... Included, typename... Excluded>
+template<typename Func>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Each(Func&& callback)
+{
+    Refresh();
+    for (Entity* const entity : _entities) callback(entity);
+}
+
+template<typename... Included, typename... Excluded>
+const std::vector<Entity*>& CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::GetEntities()
+{
+    Refresh();
+    return _entities;
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Refresh()
+{
+    if (_pending.empty()) return;
+
+    // One entity may have changed several pools since the last refresh
+    std::sort(_pending.begin(), _pending.end(), [](const entt::entity lhs, const entt::entity rhs) {
+        return entt::to_integral(lhs) < entt::to_integral(rhs);
+    });
+    _pending.erase(std::unique(_pending.begin(), _pending.end()), _pending.end());
+
+    for (const entt::entity entity : _pending)
+    {
+        if (Matches(entity)) Insert(entity);
+        else Erase(entity);
+    }
+    _pending.clear();
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Reevaluate(const Entity* const entity)
+{
+    assert(entity && entity->GetScene() == _scene && "Entity must belong to the queried scene");
+    _pending.push_back(entity->GetHandle());
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Rebuild()
+{
+    _entities.clear();
+    _handles.clear();
+    _slots.clear();
+    _pending.clear();
+
+    for (const entt::entity entity : _scene->GetRegistry().template view<Included...>())
+    {
+        if (Matches(entity)) Insert(entity);
+    }
+}
+
+// Private Methods
+
+template<typename... Included, typename... Excluded>
+bool CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Matches(const entt::entity entity)
+{
+    const entt::registry& registry = _scene->GetRegistry();
+    if (!registry.valid(entity) || !registry.template all_of<Included...>(entity)) return false;
+    if constexpr (sizeof...(Excluded) > 0)
+    {
+        if (registry.template any_of<Excluded...>(entity)) return false;
+    }
+    if (!_filter) return true;
+
+    Entity* const owner = _scene->TryGetEntity(entity);
+    return owner && _filter(owner);
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Insert(const entt::entity entity)
+{
+    if (_slots.contains(entity)) return;
+
+    Entity* const owner = _scene->TryGetEntity(entity);
+    if (!owner) return;
+
+    _slots.emplace(entity, _handles.size());
+    _handles.push_back(entity);
+    _entities.push_back(owner);
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::Erase(const entt::entity entity)
+{
+    if (!_slots.contains(entity)) return;
+
+    // Order carries no meaning, so swap with the last match instead of shifting
+    const size_t slot = _slots.get(entity);
+    const entt::entity last = _handles.back();
+    _handles[slot] = last;
+    _entities[slot] = _entities.back();
+    _slots.get(last) = slot;
+
+    _handles.pop_back();
+    _entities.pop_back();
+    _slots.erase(entity);
+}
+
+template<typename... Included, typename... Excluded>
+void CachedQuery<QuerySignature<Included...>, Exclude<Excluded...>>::OnChange(entt::registry&, const entt::entity entity)
+{
+    _pending.push_back(entity);
+}
+
+} // namespace velecs::ecs
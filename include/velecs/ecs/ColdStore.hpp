@@ -0,0 +1,59 @@
+#pragma once
+
+#include <velecs/common/Uuid.hpp>
+using velecs::common::Uuid;
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+
+/// @class ColdBox
+/// @brief Type-erased holder for a component value that has no binary codec.
+class ColdBox {
+public:
+    /// @brief Default destructor.
+    virtual ~ColdBox() = default;
+};
+
+/// @class ColdValue
+/// @brief Holds a component moved out of its pool while its entity is hibernated.
+/// @tparam ComponentType The held component type.
+template<typename ComponentType>
+class ColdValue : public ColdBox {
+public:
+    ComponentType value; ///< @brief The moved-out component.
+
+    explicit ColdValue(ComponentType&& moved)
+        : value(std::move(moved)) {}
+};
+
+/// @brief Values of a hibernated subtree whose types have no binary codec.
+using ColdBoxes = std::vector<std::unique_ptr<ColdBox>>;
+
+/// @struct HibernatedSubtree
+/// @brief A Transform subtree removed from the live registry.
+/// @details The Entity objects stay alive in the World so pointers and UUIDs held elsewhere
+///          remain valid; their handles are null until the subtree wakes up.
+///
+///          The encoding is, per entity in pre-order: the index of its parent within the
+///          subtree (or UINT32_MAX for the root), the number of components, then for each
+///          component its EnTT type id, payload size and payload. Components with a codec
+///          serialize themselves into the payload; others are moved into boxes and the
+///          payload stores the box index.
+struct HibernatedSubtree {
+    /// @brief Parent index stored for the subtree root.
+    static const uint32_t NO_PARENT = UINT32_MAX;
+
+    std::vector<Entity*> entities;  ///< @brief Hibernated entities in pre-order, root first.
+    std::vector<unsigned char> data; ///< @brief Encoded hierarchy and component values.
+    ColdBoxes boxes;                ///< @brief Values of types without a codec.
+    Uuid parent{Uuid::INVALID};     ///< @brief Parent of the root when it was hibernated.
+    size_t siblingIndex{0};         ///< @brief Index of the root among its parent's children.
+};
+
+} // namespace velecs::ecs
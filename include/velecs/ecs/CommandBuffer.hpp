@@ -0,0 +1,81 @@
+#pragma once
+
+#include "velecs/ecs/SceneCommand.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Scene;
+
+/// @class CommandBuffer
+/// @brief Structural changes recorded by one parallel chunk, applied later on the frame thread.
+///
+/// Worker threads must not create, destroy or restructure entities while a parallel query is
+/// running. They record those changes into the CommandBuffer of the chunk they are processing
+/// instead, and the scene applies every buffer in chunk order once all workers are done. Since
+/// chunks are contiguous ranges of the query, applying them in order yields the same entity
+/// handles and pool layout as running the query serially.
+class CommandBuffer {
+    friend class Scene;
+
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    CommandBuffer() = default;
+
+    /// @brief Default destructor.
+    ~CommandBuffer() = default;
+
+    // Allow move operations only, recorded callbacks may own resources
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    CommandBuffer(CommandBuffer&&) = default;
+    CommandBuffer& operator=(CommandBuffer&&) = default;
+
+    // Public Methods
+
+    /// @brief Records an entity spawn.
+    /// @param init Optional callback run on the frame thread with the newly created entity.
+    void Spawn(std::function<void(Entity* const)> init = {});
+
+    /// @brief Records an entity's destruction.
+    /// @param entity The entity to mark for destruction.
+    void Destroy(const Entity* const entity);
+
+    /// @brief Records a change to an entity, e.g. adding or removing components or reparenting.
+    /// @param entity The entity to change.
+    /// @param update Callback run on the frame thread with the entity.
+    void Update(const Entity* const entity, std::function<void(Entity* const)> update);
+
+    /// @brief Gets the index of the chunk this buffer belongs to.
+    /// @return Zero-based chunk index, stable across runs in deterministic mode.
+    /// @details Useful to seed per-chunk random number generators reproducibly.
+    inline size_t GetChunkIndex() const { return _chunkIndex; }
+
+    /// @brief Gets the number of recorded commands.
+    inline size_t GetCount() const { return _commands.size(); }
+
+    /// @brief Checks whether no commands were recorded.
+    inline bool IsEmpty() const { return _commands.empty(); }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<SceneCommand> _commands; ///< @brief Commands in recording order.
+    size_t _chunkIndex{0};               ///< @brief Chunk that recorded the commands.
+
+    // Private Methods
+};
+
+} // namespace velecs::ecs
@@ -7,14 +7,45 @@
 #include "velecs/ecs/Object.hpp"
 
 #include "velecs/ecs/Scene.hpp"
+#include "velecs/ecs/SceneStats.hpp"
+#include "velecs/ecs/SceneCommand.hpp"
+#include "velecs/ecs/SceneReleaser.hpp"
+#include "velecs/ecs/SceneCompaction.hpp"
+#include "velecs/ecs/RelationIndex.hpp"
 
 #include "velecs/ecs/Entity.hpp"
 #include "velecs/ecs/EntityBuilder.hpp"
+#include "velecs/ecs/EntityReservation.hpp"
 
 #include "velecs/ecs/Tag.hpp"
 #include "velecs/ecs/Tags/DestroyTag.hpp"
 
 #include "velecs/ecs/Component.hpp"
+#include "velecs/ecs/ComponentTraits.hpp"
 #include "velecs/ecs/Components/Transform.hpp"
+#include "velecs/ecs/Components/Affine3x4.hpp"
+#include "velecs/ecs/RotationBatch.hpp"
 
 #include "velecs/ecs/System.hpp"
+#include "velecs/ecs/FusedSystem.hpp"
+
+#include "velecs/ecs/QuerySignature.hpp"
+#include "velecs/ecs/SortedQuery.hpp"
+#include "velecs/ecs/CachedQuery.hpp"
+
+#include "velecs/ecs/EventChannel.hpp"
+
+#include "velecs/ecs/WorkerPool.hpp"
+#include "velecs/ecs/CommandBuffer.hpp"
+
+#include "velecs/ecs/StateHasher.hpp"
+#include "velecs/ecs/ComponentRegistry.hpp"
+
+#include "velecs/ecs/BinaryStream.hpp"
+#include "velecs/ecs/ColdStore.hpp"
+
+#include "velecs/ecs/WorldPartition.hpp"
+
+#include "velecs/ecs/SceneJournal.hpp"
+
+#include "velecs/ecs/MetricsExporter.hpp"
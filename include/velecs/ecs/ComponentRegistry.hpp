@@ -0,0 +1,121 @@
+#pragma once
+
+#include "velecs/ecs/BinaryStream.hpp"
+#include "velecs/ecs/ColdStore.hpp"
+#include "velecs/ecs/StateHasher.hpp"
+
+#include <entt/entt.hpp>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace velecs::ecs {
+
+class Component;
+
+/// @brief Detects components with a binary codec.
+/// @details A component opts in by providing `void Serialize(BinaryWriter&) const` and
+///          `void Deserialize(BinaryReader&)`. Codecs should only write plain data; references
+///          to other entities are restored by the scene, not by the codec.
+template<typename T, typename = void>
+struct HasCodec : std::false_type {};
+
+template<typename T>
+struct HasCodec<T, std::void_t<
+    decltype(std::declval<const T&>().Serialize(std::declval<BinaryWriter&>())),
+    decltype(std::declval<T&>().Deserialize(std::declval<BinaryReader&>()))>>
+    : std::true_type {};
+
+/// @struct ComponentOps
+/// @brief Type-erased operations on the pool of a single component type.
+/// @details Lets scene-wide features walk the registry's type-erased pools and still reach
+///          component values. Operations a type does not support are left null.
+struct ComponentOps {
+    std::string name; ///< @brief Type name of the component.
+    size_t valueSize{0}; ///< @brief Bytes each value takes in the pool, zero for empty types.
+
+    bool mainThreadDestruction{false}; ///< @brief Values must be destroyed on the frame thread, see ComponentTraits.
+
+    /// @brief Feeds every value of the pool into a hasher, in pool order.
+    void (*hashState)(const entt::sparse_set& pool, StateHasher& hasher){nullptr};
+
+    /// @brief Writes an entity's value out of the pool, leaving the pool untouched.
+    /// @details Serializes through the codec if the type has one, otherwise moves the value
+    ///          into boxes and writes the box index. Returns false if neither is possible,
+    ///          including when boxes is null.
+    bool (*freeze)(entt::sparse_set& pool, const entt::entity entity, BinaryWriter& writer, ColdBoxes* boxes){nullptr};
+
+    /// @brief Recreates a frozen value on an entity.
+    /// @return The recreated component so the caller can set its owner, or nullptr for tags.
+    Component* (*thaw)(entt::registry& registry, const entt::entity entity, BinaryReader& reader, ColdBoxes* boxes){nullptr};
+
+    /// @brief Overwrites an entity's existing value through the codec.
+    /// @details Null for types without a codec.
+    void (*load)(entt::registry& registry, const entt::entity entity, BinaryReader& reader){nullptr};
+};
+
+/// @class ComponentRegistry
+/// @brief Process-wide table of ComponentOps keyed by EnTT type id.
+///
+/// Scenes register a component or tag type the first time they create it, so every type
+/// found in a live registry pool is known here. Data loaded from disk may reference types the
+/// process has not created yet; register those up front with Register<T>(). Registration and
+/// lookup are thread-safe.
+class ComponentRegistry {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Deleted default constructor, the registry is static only.
+    ComponentRegistry() = delete;
+
+    // Public Methods
+
+    /// @brief Registers the operations of a component or tag type once.
+    /// @tparam ComponentType The component or tag type to register.
+    /// @details Cheap after the first call for a type.
+    template<typename ComponentType>
+    static void Register();
+
+    /// @brief Looks up the operations of a component type.
+    /// @param id EnTT type id of the component, as reported by the registry's pools.
+    /// @param outOps Set to the operations if the type is registered.
+    /// @return True if the type is registered.
+    /// @details Entries are never removed, so the returned pointer stays valid.
+    static bool TryGet(const entt::id_type id, const ComponentOps*& outOps);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+
+    /// @brief Stores the operations of a type unless it is already registered.
+    static void Insert(const entt::id_type id, ComponentOps&& ops);
+
+    /// @brief Hashes every value of a component pool.
+    template<typename ComponentType>
+    static void HashPool(const entt::sparse_set& pool, StateHasher& hasher);
+
+    /// @brief Writes a single value out of a pool.
+    template<typename ComponentType>
+    static bool Freeze(entt::sparse_set& pool, const entt::entity entity, BinaryWriter& writer, ColdBoxes* boxes);
+
+    /// @brief Recreates a single frozen value.
+    template<typename ComponentType>
+    static Component* Thaw(entt::registry& registry, const entt::entity entity, BinaryReader& reader, ColdBoxes* boxes);
+
+    /// @brief Overwrites a single value through the codec.
+    template<typename ComponentType>
+    static void Load(entt::registry& registry, const entt::entity entity, BinaryReader& reader);
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/ComponentRegistry.inl"
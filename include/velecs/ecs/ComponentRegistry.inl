@@ -0,0 +1,113 @@
+#include "velecs/ecs/Component.hpp"
+#include "velecs/ecs/Tag.hpp"
+
+#include <stdexcept>
+
+namespace velecs::ecs {
+
+// Public Methods
+
+template<typename ComponentType>
+void ComponentRegistry::Register()
+{
+    static const bool registered = []() {
+        ComponentOps ops;
+        ops.name = std::string(entt::type_id<ComponentType>().name());
+        if constexpr (!std::is_empty_v<ComponentType>) ops.valueSize = sizeof(ComponentType);
+        if constexpr (std::is_base_of_v<Component, ComponentType>)
+        {
+            ops.mainThreadDestruction = ComponentTraits<ComponentType>::mainThreadDestruction;
+        }
+        if constexpr (HasHashState<ComponentType>::value) ops.hashState = &HashPool<ComponentType>;
+        ops.freeze = &Freeze<ComponentType>;
+        ops.thaw = &Thaw<ComponentType>;
+        if constexpr (HasCodec<ComponentType>::value) ops.load = &Load<ComponentType>;
+        Insert(entt::type_hash<ComponentType>::value(), std::move(ops));
+        return true;
+    }();
+    (void)registered;
+}
+
+// Private Methods
+
+template<typename ComponentType>
+void ComponentRegistry::HashPool(const entt::sparse_set& pool, StateHasher& hasher)
+{
+    const auto& storage = static_cast<const entt::storage_for_t<ComponentType>&>(pool);
+
+    // Values and handles share their order, so walk both instead of a sparse lookup per entity
+    auto value = storage.cbegin();
+    for (auto entity = pool.begin(); entity != pool.end(); ++entity, ++value)
+    {
+        // Skip slots left behind by in-place deletion
+        if (*entity == entt::tombstone) continue;
+        value->HashState(hasher);
+    }
+}
+
+template<typename ComponentType>
+bool ComponentRegistry::Freeze(entt::sparse_set& pool, const entt::entity entity, BinaryWriter& writer, ColdBoxes* boxes)
+{
+    auto& storage = static_cast<entt::storage_for_t<ComponentType>&>(pool);
+
+    if constexpr (std::is_base_of_v<Tag, ComponentType>)
+    {
+        // Membership is all there is to a tag
+        return true;
+    }
+    else if constexpr (HasCodec<ComponentType>::value)
+    {
+        storage.get(entity).Serialize(writer);
+        return true;
+    }
+    else if constexpr (std::is_move_constructible_v<ComponentType>)
+    {
+        if (!boxes) return false;
+        writer.Write(static_cast<uint32_t>(boxes->size()));
+        boxes->push_back(std::make_unique<ColdValue<ComponentType>>(std::move(storage.get(entity))));
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<typename ComponentType>
+Component* ComponentRegistry::Thaw(entt::registry& registry, const entt::entity entity, BinaryReader& reader, ColdBoxes* boxes)
+{
+    if constexpr (std::is_base_of_v<Tag, ComponentType>)
+    {
+        registry.emplace<ComponentType>(entity);
+        return nullptr;
+    }
+    else if constexpr (HasCodec<ComponentType>::value)
+    {
+        ComponentType& comp = registry.emplace<ComponentType>(entity);
+        comp.Deserialize(reader);
+        return &comp;
+    }
+    else if constexpr (std::is_move_constructible_v<ComponentType>)
+    {
+        const uint32_t index = reader.Read<uint32_t>();
+        if (!boxes || index >= boxes->size())
+        {
+            throw std::runtime_error("Frozen component references a missing cold value");
+        }
+
+        auto& box = static_cast<ColdValue<ComponentType>&>(*(*boxes)[index]);
+        return &registry.emplace<ComponentType>(entity, std::move(box.value));
+    }
+    else
+    {
+        throw std::runtime_error("Component type cannot be thawed without a codec");
+    }
+}
+
+template<typename ComponentType>
+void ComponentRegistry::Load(entt::registry& registry, const entt::entity entity, BinaryReader& reader)
+{
+    registry.get<ComponentType>(entity).Deserialize(reader);
+}
+
+} // namespace velecs::ecs
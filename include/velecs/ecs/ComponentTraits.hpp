@@ -0,0 +1,61 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace velecs::ecs {
+
+class Component;
+
+/// @struct DefaultComponentTraits
+/// @brief Storage behavior every component type gets unless it specializes ComponentTraits.
+struct DefaultComponentTraits {
+    /// @brief Leave a tombstone on removal instead of moving the last component into the hole.
+    /// @details Keeps pointers to the other components of the pool stable, at the cost of holes
+    ///          that iteration has to skip until the pool is compacted.
+    static constexpr bool inPlaceDelete = false;
+
+    /// @brief Number of components per storage page. Must be a power of two.
+    /// @details Pages never move once allocated. Tiny, numerous components benefit from larger
+    ///          pages, rare large ones from smaller pages.
+    static constexpr size_t pageSize = 1024;
+
+    /// @brief Destructors must run on the frame thread.
+    /// @details Set this for components that release resources owned by the frame thread, such
+    ///          as GPU handles. Their pools are destroyed before an outgoing scene is handed to
+    ///          the SceneManager's background releaser.
+    static constexpr bool mainThreadDestruction = false;
+};
+
+/// @struct ComponentTraits
+/// @brief Customization point for how a component type is stored.
+/// @tparam ComponentType The component type.
+/// @details Specialize it next to the component, before the type is first used by a scene,
+///          and derive from DefaultComponentTraits to only override what differs:
+/// @code
+/// template<>
+/// struct ComponentTraits<Particle> : DefaultComponentTraits {
+///     static constexpr size_t pageSize = 8192;
+///     static constexpr bool inPlaceDelete = true;
+/// };
+/// @endcode
+///          The traits are checked by validate_component() and forwarded to EnTT, so every
+///          scene creates the pool of the type with this layout.
+template<typename ComponentType>
+struct ComponentTraits : DefaultComponentTraits {};
+
+} // namespace velecs::ecs
+
+namespace entt {
+
+/// @brief Forwards velecs::ecs::ComponentTraits to the storage EnTT creates for every component.
+template<typename Type>
+struct component_traits<Type, std::enable_if_t<std::is_base_of_v<velecs::ecs::Component, Type>>> {
+    using type = Type;
+    static constexpr bool in_place_delete = velecs::ecs::ComponentTraits<Type>::inPlaceDelete;
+    static constexpr std::size_t page_size = velecs::ecs::ComponentTraits<Type>::pageSize;
+};
+
+} // namespace entt
@@ -107,6 +107,12 @@ public:
 
     Scene* const GetScene() const { return _scene; }
 
+    /// @brief Gets the EnTT handle of this entity.
+    /// @return The handle, or entt::null for invalid entities.
+    /// @details Handles are allocated deterministically, which makes them a stable identity
+    ///          for hashing and serialization where pointers and UUIDs are not.
+    inline entt::entity GetHandle() const { return _handle; }
+
     /// @brief Gets the Transform component of this entity.
     /// @details This is a convenience method that assumes the entity has a Transform component.
     ///          This method should only be called when you know the entity has a Transform.
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "velecs/ecs/Scene.hpp"
+#include "velecs/ecs/TypeConstraints.hpp"
+
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Transform;
+
+/// @class StagedPool
+/// @brief Type-erased buffer of components or tags staged for a single type.
+class StagedPool {
+public:
+    /// @brief Default destructor.
+    virtual ~StagedPool() = default;
+
+    /// @brief Moves the staged values into the scene's registry.
+    /// @param scene The scene that owns the staged entities.
+    virtual void Commit(Scene& scene) = 0;
+
+    /// @brief Gets the number of staged values.
+    virtual size_t GetCount() const = 0;
+};
+
+/// @class StagedComponents
+/// @brief Components of one type staged for reserved entities.
+/// @tparam ComponentType The staged component type.
+template<typename ComponentType>
+class StagedComponents : public StagedPool {
+public:
+    std::vector<Entity*> owners;        ///< @brief Entity receiving each staged value.
+    std::vector<ComponentType> values;  ///< @brief Staged values, parallel to owners.
+
+    inline void Commit(Scene& scene) override { scene.CommitStaged<ComponentType>(owners, values); }
+
+    inline size_t GetCount() const override { return values.size(); }
+};
+
+/// @class StagedTags
+/// @brief Tags of one type staged for reserved entities.
+/// @tparam TagType The staged tag type.
+template<typename TagType>
+class StagedTags : public StagedPool {
+public:
+    std::vector<Entity*> owners; ///< @brief Entities receiving the tag.
+
+    inline void Commit(Scene& scene) override { scene.CommitStagedTags<TagType>(owners); }
+
+    inline size_t GetCount() const override { return owners.size(); }
+};
+
+/// @class SpawnStaging
+/// @brief Thread-local staging buffer for components of reserved entities.
+///
+/// Each worker thread writes to its own SpawnStaging, so staging needs no synchronization.
+/// Nothing touches the registry until Scene::CommitReservation() merges every staging buffer
+/// on the frame thread, one pool-sized batch per component type.
+class SpawnStaging {
+    friend class Scene;
+
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    SpawnStaging() = default;
+
+    /// @brief Default destructor.
+    ~SpawnStaging() = default;
+
+    // Public Methods
+
+    /// @brief Stages a component for a reserved entity.
+    /// @tparam ComponentType The type of component to stage. Must inherit from Component.
+    /// @param entity The reserved entity receiving the component.
+    /// @param args Constructor arguments for the component.
+    /// @return Reference to the staged component, valid until the next Stage call for the same type.
+    /// @details Staging the same type twice for an entity keeps the last value. The Transform
+    ///          already exists on reserved entities and is edited directly instead.
+    template<typename ComponentType, typename = IsComponent<ComponentType>, typename... Args>
+    ComponentType& Stage(Entity* const entity, Args&&... args)
+    {
+        static_assert(!std::is_same_v<ComponentType, Transform>,
+            "Reserved entities already own a Transform, edit it through Entity::GetTransform().");
+
+        auto& pool = GetOrCreatePool<StagedComponents<ComponentType>>(typeid(ComponentType));
+        pool.owners.push_back(entity);
+        return pool.values.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// @brief Stages a tag for a reserved entity.
+    /// @tparam TagType The type of tag to stage. Must inherit from Tag.
+    /// @param entity The reserved entity receiving the tag.
+    template<typename TagType, typename = IsTag<TagType>>
+    void StageTag(Entity* const entity)
+    {
+        GetOrCreatePool<StagedTags<TagType>>(typeid(TagType)).owners.push_back(entity);
+    }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @brief Staged types in first-staged order so commits are deterministic.
+    std::vector<std::type_index> _order;
+    /// @brief Staged values per type.
+    std::unordered_map<std::type_index, std::unique_ptr<StagedPool>> _pools;
+
+    // Private Methods
+
+    template<typename PoolT>
+    PoolT& GetOrCreatePool(const std::type_index id)
+    {
+        auto it = _pools.find(id);
+        if (it == _pools.end())
+        {
+            it = _pools.emplace(id, std::make_unique<PoolT>()).first;
+            _order.push_back(id);
+        }
+        return static_cast<PoolT&>(*it->second);
+    }
+};
+
+/// @class EntityReservation
+/// @brief A block of entities created up front for parallel construction.
+///
+/// Scene::ReserveEntities() creates every handle, Entity object and Transform in one batch on
+/// the frame thread. Workers then each take a SpawnStaging buffer and a disjoint range of the
+/// reserved entities, configure transforms and stage components without touching the shared
+/// registry, and Scene::CommitReservation() merges the buffers back in staging order.
+///
+/// @code
+/// EntityReservation wave = scene->ReserveEntities(10000, workerCount);
+/// // On each worker i:
+/// auto [begin, end] = wave.GetRange(i);
+/// for (size_t j = begin; j < end; ++j)
+/// {
+///     wave[j]->GetTransform().SetPos(spawnPoints[j]);
+///     wave.GetStaging(i).Stage<Velocity>(wave[j]);
+/// }
+/// // Back on the frame thread:
+/// scene->CommitReservation(wave);
+/// @endcode
+class EntityReservation {
+    friend class Scene;
+
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Deleted default constructor.
+    EntityReservation() = delete;
+
+    /// @brief Default destructor.
+    ~EntityReservation() = default;
+
+    // Allow move operations only, staging buffers are not copyable
+    EntityReservation(const EntityReservation&) = delete;
+    EntityReservation& operator=(const EntityReservation&) = delete;
+    EntityReservation(EntityReservation&&) = default;
+    EntityReservation& operator=(EntityReservation&&) = default;
+
+    // Public Methods
+
+    /// @brief Gets a reserved entity by index.
+    /// @param index Zero-based index into the reservation.
+    /// @return The reserved entity.
+    inline Entity* operator[](const size_t index) const { return _entities[index]; }
+
+    /// @brief Gets the number of reserved entities.
+    inline size_t GetCount() const { return _entities.size(); }
+
+    /// @brief Gets every reserved entity in creation order.
+    inline const std::vector<Entity*>& GetEntities() const { return _entities; }
+
+    /// @brief Gets the number of staging buffers (usually one per worker).
+    inline size_t GetStagingCount() const { return _stagings.size(); }
+
+    /// @brief Gets a staging buffer.
+    /// @param index Zero-based staging buffer index, one per worker.
+    /// @return The staging buffer. Must only be used by one thread at a time.
+    inline SpawnStaging& GetStaging(const size_t index) { return _stagings[index]; }
+
+    /// @brief Gets the evenly split range of entities assigned to a staging buffer.
+    /// @param index Zero-based staging buffer index.
+    /// @return Half-open [begin, end) index range into the reservation.
+    inline std::pair<size_t, size_t> GetRange(const size_t index) const
+    {
+        const size_t count = _entities.size();
+        const size_t parts = _stagings.size();
+        return { count * index / parts, count * (index + 1) / parts };
+    }
+
+    /// @brief Checks whether the reservation was already committed.
+    inline bool IsCommitted() const { return _committed; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    Scene* _scene{nullptr};              ///< @brief Scene that owns the reserved entities.
+    std::vector<Entity*> _entities;      ///< @brief Reserved entities in creation order.
+    std::vector<SpawnStaging> _stagings; ///< @brief One staging buffer per worker.
+    bool _committed{false};              ///< @brief Whether the staging was merged already.
+
+    // Private Methods
+
+    inline EntityReservation(Scene* const scene, std::vector<Entity*>&& entities, const size_t stagingCount)
+        : _scene(scene), _entities(std::move(entities)), _stagings(stagingCount > 0 ? stagingCount : 1) {}
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace velecs::ecs {
+
+class WorkerPool;
+
+/// @class EventChannel
+/// @brief Double-buffered stream of one event type, written during a frame and read the next.
+/// @tparam EventType The event, any movable type, e.g. `struct DamageDealt { Entity* target; float amount; };`.
+///
+/// Every pool thread appends to its own buffer, so systems, parallel queries and command
+/// callbacks can all send events without locking. Any other thread, such as a streaming or
+/// release thread, or a worker of another world's pool, appends to one shared buffer under a
+/// lock. The scene manager swaps the write and read sides at the start of each frame's main
+/// phase: events sent during frame N are read during frame N + 1, as one contiguous batch per
+/// writing thread. Buffers are cleared without releasing their memory, so once a channel has
+/// seen its busiest frame, sending allocates nothing.
+///
+/// Within a batch events keep the order they were sent in. Batches are visited in thread
+/// order, the shared buffer last, and parallel chunks are claimed dynamically, so the order
+/// across batches is only reproducible for events sent from the frame thread.
+///
+/// Channels are owned by their scene, see Scene::GetEventChannel():
+/// @code
+/// scene->GetEventChannel<DamageDealt>().Send(DamageDealt{target, 10.0f});
+/// scene->GetEventChannel<DamageDealt>().Each([](const DamageDealt& hit) { Apply(hit); });
+/// @endcode
+template<typename EventType>
+class EventChannel {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a channel with one write buffer per pool thread, plus the shared one.
+    /// @param pool The pool whose tasks send without locking.
+    /// @details Must be called on the frame thread, which is the one writing buffer zero.
+    explicit EventChannel(const WorkerPool& pool);
+
+    /// @brief Deleted default constructor.
+    EventChannel() = delete;
+
+    /// @brief Default deconstructor.
+    ~EventChannel() = default;
+
+    // Delete copy and move operations since senders may hold a reference to the channel
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+    EventChannel(EventChannel&&) = delete;
+    EventChannel& operator=(EventChannel&&) = delete;
+
+    // Public Methods
+
+    /// @brief Sends an event, readable after the next swap.
+    /// @param event The event to send.
+    /// @details Safe from any thread, concurrently. Threads other than the frame thread and
+    ///          the pool's workers take a lock. Must not overlap with a swap, except on those
+    ///          other threads.
+    void Send(EventType event);
+
+    /// @brief Constructs an event in place, readable after the next swap.
+    /// @param args Arguments forwarded to the event's constructor.
+    /// @details Same threading rules as Send().
+    template<typename... Args>
+    void Emplace(Args&&... args);
+
+    /// @brief Calls a function on every batch of last frame's events.
+    /// @param callback Called as callback(const EventType* events, size_t count), once per
+    ///        non-empty batch.
+    template<typename Func>
+    void EachBatch(Func&& callback) const;
+
+    /// @brief Calls a function on every one of last frame's events.
+    /// @param callback Called as callback(const EventType&).
+    template<typename Func>
+    void Each(Func&& callback) const;
+
+    /// @brief Gets the number of events readable this frame.
+    inline size_t GetCount() const { return _readCount; }
+
+    /// @brief Checks whether no events are readable this frame.
+    inline bool IsEmpty() const { return _readCount == 0; }
+
+    /// @brief Makes the events sent since the last swap readable and drops the ones read.
+    /// @details Called by the scene manager once per frame. Must not overlap with Send().
+    void Swap();
+
+    /// @brief Drops every readable and pending event, keeping the buffers' memory.
+    void Clear();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @brief Events sent by one thread, on its own cache line so writers do not contend.
+    struct alignas(64) ThreadBuffer {
+        std::vector<EventType> events; ///< @brief Events in sending order.
+    };
+
+    const WorkerPool* const _pool;      ///< @brief Pool whose workers own a write buffer.
+    const std::thread::id _frameThread; ///< @brief Thread owning write buffer zero.
+
+    std::vector<ThreadBuffer> _writeBuffers; ///< @brief Events sent this frame, by thread, the shared buffer last.
+    std::vector<ThreadBuffer> _readBuffers;  ///< @brief Events sent last frame, by thread, the shared buffer last.
+    size_t _readCount{0};                    ///< @brief Number of events in the read buffers.
+    std::mutex _sharedMutex;                 ///< @brief Guards the shared write buffer and the swap.
+
+    // Private Methods
+
+    /// @brief Gets the calling thread's own write buffer.
+    /// @return nullptr on threads that must use the shared buffer.
+    std::vector<EventType>* TryGetOwnWriteBuffer();
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/EventChannel.inl"
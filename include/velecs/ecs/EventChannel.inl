@@ -0,0 +1,102 @@
+#include "velecs/ecs/WorkerPool.hpp"
+
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace velecs::ecs {
+
+// Constructors and Destructors
+
+template<typename EventType>
+EventChannel<EventType>::EventChannel(const WorkerPool& pool)
+    : _pool(&pool), _frameThread(std::this_thread::get_id()),
+      _writeBuffers(pool.GetThreadCount() + 1), _readBuffers(pool.GetThreadCount() + 1) {}
+
+// Public Methods
+
+template<typename EventType>
+void EventChannel<EventType>::Send(EventType event)
+{
+    if (std::vector<EventType>* const buffer = TryGetOwnWriteBuffer())
+    {
+        buffer->push_back(std::move(event));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    _writeBuffers.back().events.push_back(std::move(event));
+}
+
+template<typename EventType>
+template<typename... Args>
+void EventChannel<EventType>::Emplace(Args&&... args)
+{
+    if (std::vector<EventType>* const buffer = TryGetOwnWriteBuffer())
+    {
+        buffer->emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    _writeBuffers.back().events.emplace_back(std::forward<Args>(args)...);
+}
+
+template<typename EventType>
+template<typename Func>
+void EventChannel<EventType>::EachBatch(Func&& callback) const
+{
+    for (const ThreadBuffer& buffer : _readBuffers)
+    {
+        if (!buffer.events.empty()) callback(buffer.events.data(), buffer.events.size());
+    }
+}
+
+template<typename EventType>
+template<typename Func>
+void EventChannel<EventType>::Each(Func&& callback) const
+{
+    for (const ThreadBuffer& buffer : _readBuffers)
+    {
+        for (const EventType& event : buffer.events) callback(event);
+    }
+}
+
+template<typename EventType>
+void EventChannel<EventType>::Swap()
+{
+    // Threads outside the pool are not synchronized with the frame, so they may still be sending
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    _writeBuffers.swap(_readBuffers);
+
+    // The old read side becomes the write side, clear() keeps its capacity for this frame
+    _readCount = 0;
+    for (size_t i = 0; i < _readBuffers.size(); ++i)
+    {
+        _writeBuffers[i].events.clear();
+        _readCount += _readBuffers[i].events.size();
+    }
+}
+
+template<typename EventType>
+void EventChannel<EventType>::Clear()
+{
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    for (ThreadBuffer& buffer : _writeBuffers) buffer.events.clear();
+    for (ThreadBuffer& buffer : _readBuffers) buffer.events.clear();
+    _readCount = 0;
+}
+
+// Private Methods
+
+template<typename EventType>
+std::vector<EventType>* EventChannel<EventType>::TryGetOwnWriteBuffer()
+{
+    // Every non-worker thread reports index zero, so only the frame thread may take that buffer
+    const WorkerPool* const pool = WorkerPool::GetCurrentPool();
+    if (pool == _pool) return &_writeBuffers[WorkerPool::GetCurrentThreadIndex()].events;
+    if (pool == nullptr && std::this_thread::get_id() == _frameThread) return &_writeBuffers.front().events;
+    return nullptr;
+}
+
+} // namespace velecs::ecs
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "velecs/ecs/QuerySignature.hpp"
+#include "velecs/ecs/System.hpp"
+
+#include <tuple>
+#include <type_traits>
+
+namespace velecs::ecs {
+
+class Entity;
+
+/// @enum SystemPhase
+/// @brief Processing phase a FusedSystem runs its kernels in.
+enum class SystemPhase {
+    Process, ///< @brief Main logic phase, see System::Process().
+    Physics, ///< @brief Physics phase, see System::ProcessPhysics().
+    GUI,     ///< @brief GUI phase, see System::ProcessGUI().
+};
+
+/// @class FusedSystem
+/// @brief Runs several kernels over one query in a single pass.
+/// @tparam Signature A QuerySignature listing the queried tags and components.
+/// @tparam Kernels Kernel types, run in the listed order.
+///
+/// Small systems that each run the same query stream the same components through the cache once
+/// per system. A fused system iterates the query once and runs every kernel on an entity before
+/// moving to the next one, with the kernel calls inlined into the loop.
+///
+/// A kernel is a default-constructible type callable as
+/// `void operator()(void* context, Entity* entity, Components&... components)`, where Components
+/// are the signature's components in the listed order. Tags only filter the query and are not
+/// passed, the same as with Scene::Query(). Each entity
+/// sees the kernels in the listed order, exactly as if the systems ran back to back. Fusion only
+/// reorders work across entities, so a kernel may only read and write the entity it is handed,
+/// the same rule ParallelQuery() follows.
+///
+/// @code
+/// struct Integrate { void operator()(void* ctx, Entity*, Transform& t, Velocity& v) const; };
+/// struct Drag      { void operator()(void* ctx, Entity*, Transform& t, Velocity& v) const; };
+/// struct Clamp     { void operator()(void* ctx, Entity*, Transform& t, Velocity& v) const; };
+///
+/// using Movement = FusedSystem<QuerySignature<Transform, Velocity, Moving>, Integrate, Drag, Clamp>;
+/// scene->TryAddSystem<Movement>(SystemPhase::Physics);
+/// @endcode
+template<typename Signature, typename... Kernels>
+class FusedSystem;
+
+template<typename... ComponentTypes, typename... Kernels>
+class FusedSystem<QuerySignature<ComponentTypes...>, Kernels...> : public System {
+    static_assert(sizeof...(ComponentTypes) > 0, "A fused system needs at least one queried type");
+    static_assert(sizeof...(Kernels) > 0, "A fused system needs at least one kernel");
+
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates the fused system with default-constructed kernels.
+    /// @param phase The phase the kernels run in.
+    explicit FusedSystem(const SystemPhase phase = SystemPhase::Process)
+        : _phase(phase) {}
+
+    /// @brief Default destructor.
+    ~FusedSystem() override = default;
+
+    // Public Methods
+
+    /// @brief Gets one of the kernels, to configure its state.
+    /// @tparam Kernel The kernel type. Must appear once in Kernels.
+    template<typename Kernel>
+    inline Kernel& GetKernel() { return std::get<Kernel>(_kernels); }
+
+    /// @brief Gets the phase the kernels run in.
+    inline SystemPhase GetPhase() const { return _phase; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+    void Process(void* context) override;
+
+    void ProcessPhysics(void* context) override;
+
+    void ProcessGUI(void* context) override;
+
+private:
+    // Private Fields
+
+    const SystemPhase _phase;         ///< @brief The phase the kernels run in.
+    std::tuple<Kernels...> _kernels;  ///< @brief Kernel instances, in run order.
+
+    // Private Methods
+
+    /// @brief Runs every kernel on every matching entity in one pass.
+    void Run(void* context);
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/FusedSystem.inl"
@@ -0,0 +1,46 @@
+#include "velecs/ecs/Scene.hpp"
+
+#include <cassert>
+
+namespace velecs::ecs {
+
+// Protected Methods
+
+template<typename... ComponentTypes, typename... Kernels>
+void FusedSystem<QuerySignature<ComponentTypes...>, Kernels...>::Process(void* context)
+{
+    if (_phase == SystemPhase::Process) Run(context);
+}
+
+template<typename... ComponentTypes, typename... Kernels>
+void FusedSystem<QuerySignature<ComponentTypes...>, Kernels...>::ProcessPhysics(void* context)
+{
+    if (_phase == SystemPhase::Physics) Run(context);
+}
+
+template<typename... ComponentTypes, typename... Kernels>
+void FusedSystem<QuerySignature<ComponentTypes...>, Kernels...>::ProcessGUI(void* context)
+{
+    if (_phase == SystemPhase::GUI) Run(context);
+}
+
+// Private Methods
+
+template<typename... ComponentTypes, typename... Kernels>
+void FusedSystem<QuerySignature<ComponentTypes...>, Kernels...>::Run(void* context)
+{
+    Scene* const scene = GetScene();
+    assert(scene && "A fused system only runs once it is added to a scene");
+
+    // each() hands over the components only, tags just narrow the view
+    scene->GetRegistry().template view<ComponentTypes...>().each([this, scene, context](const entt::entity handle, auto&... comps) {
+        static_assert((std::is_invocable_v<Kernels&, void*, Entity*, decltype(comps)...> && ...),
+            "Every kernel must be callable as kernel(void* context, Entity* entity, Components&...) without the tags");
+
+        Entity* const entity = scene->TryGetEntity(handle);
+        assert(entity && "Should always be able to lookup entity via entt handle");
+        std::apply([&](Kernels&... kernels) { (kernels(context, entity, comps...), ...); }, _kernels);
+    });
+}
+
+} // namespace velecs::ecs
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "velecs/ecs/SceneStats.hpp"
+#include "velecs/ecs/System.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace velecs::ecs {
+
+/// @struct MetricsSnapshot
+/// @brief Plain copy of the ECS metrics gathered on the frame thread.
+/// @details Holds no pointers into the ECS so it can be handed to the exporter thread and
+///          serialized there while the frame continues.
+struct MetricsSnapshot {
+    /// @brief Size of a single component or tag pool.
+    struct PoolMetrics {
+        std::string name;   ///< @brief Type name of the pool's component or tag.
+        size_t size{0};     ///< @brief Number of entities in the pool.
+        size_t capacity{0}; ///< @brief Number of entities the pool can hold without growing.
+    };
+
+    /// @brief Last-run timings of a single system.
+    struct SystemMetrics {
+        std::string name;      ///< @brief Type name of the system.
+        SystemTimings timings; ///< @brief Per-phase durations of the system's last run.
+    };
+
+    /// @brief Metrics of a single scene.
+    struct SceneMetrics {
+        std::string name;                   ///< @brief Name of the scene.
+        size_t entityCount{0};              ///< @brief Number of live entities.
+        uint64_t lastCleanupCount{0};       ///< @brief Entities destroyed by the last cleanup phase.
+        uint64_t totalCleanupCount{0};      ///< @brief Entities destroyed by all cleanup phases.
+        SceneStats frameStats;              ///< @brief Hot-path counters of the last completed frame.
+        std::vector<PoolMetrics> pools;     ///< @brief Component and tag pool sizes.
+        std::vector<SystemMetrics> systems; ///< @brief Per-system timings in execution order.
+    };
+
+    std::vector<SceneMetrics> scenes;                   ///< @brief Metrics of every collected scene.
+    uint64_t transitionCount{0};                        ///< @brief Scene transitions processed so far.
+    std::chrono::nanoseconds lastTransitionDuration{0}; ///< @brief Duration of the last scene transition.
+};
+
+/// @class MetricsExporter
+/// @brief Periodically writes ECS metrics as OpenMetrics text to a file or Unix-domain socket.
+///
+/// The frame thread only copies a MetricsSnapshot once per interval and hands it over with
+/// TrySubmit(), which never blocks: if the exporter thread is busy the snapshot is dropped and
+/// the next interval tries again. Serialization and I/O happen on the exporter's own thread.
+///
+/// File targets are rewritten atomically (write to a temporary file, then rename) so a scraper
+/// such as the Prometheus node exporter textfile collector never reads a partial snapshot.
+/// Socket targets connect to a listening Unix-domain stream socket and send one snapshot per
+/// connection. Socket targets are not available on Windows builds.
+///
+/// @code
+/// auto exporter = std::make_unique<MetricsExporter>(
+///     MetricsExporter::Target::File, "metrics/ecs.prom", std::chrono::seconds(5));
+/// world->scenes->SetMetricsExporter(exporter.get());
+/// @endcode
+class MetricsExporter {
+public:
+    // Public Fields
+
+    /// @enum Target
+    /// @brief Destination the exporter writes snapshots to.
+    enum class Target {
+        File,       ///< @brief Regular file, replaced atomically on each export.
+        UnixSocket, ///< @brief Unix-domain stream socket, one connection per export.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Starts an exporter thread writing to the given destination.
+    /// @param target Kind of destination.
+    /// @param path File path or socket path.
+    /// @param interval Minimum time between two snapshots.
+    MetricsExporter(const Target target, const std::string& path, const std::chrono::milliseconds interval);
+
+    /// @brief Deleted default constructor.
+    MetricsExporter() = delete;
+
+    /// @brief Stops the exporter thread after it finishes any export in progress.
+    ~MetricsExporter();
+
+    // Delete copy and move operations since the exporter owns a running thread
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+    MetricsExporter(MetricsExporter&&) = delete;
+    MetricsExporter& operator=(MetricsExporter&&) = delete;
+
+    // Public Methods
+
+    /// @brief Checks whether the exporter wants a new snapshot.
+    /// @return True once the interval has elapsed since the last accepted snapshot.
+    /// @details Cheap enough to call every frame; lets callers skip collection entirely.
+    bool IsSnapshotDue() const;
+
+    /// @brief Hands a snapshot to the exporter thread without blocking.
+    /// @param snapshot The snapshot to export.
+    /// @return True if the snapshot was accepted, false if the exporter thread was busy.
+    bool TrySubmit(MetricsSnapshot&& snapshot);
+
+    /// @brief Serializes a snapshot using the OpenMetrics text format.
+    /// @param snapshot The snapshot to serialize.
+    /// @return The exposition text, terminated by "# EOF".
+    static std::string Serialize(const MetricsSnapshot& snapshot);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    const Target _target;                       ///< @brief Kind of destination.
+    const std::string _path;                    ///< @brief File or socket path.
+    const std::chrono::milliseconds _interval;  ///< @brief Minimum time between snapshots.
+
+    /// @brief Steady clock time (in nanoseconds) after which the next snapshot is due.
+    std::atomic<int64_t> _nextDue{0};
+
+    std::mutex _mutex;                          ///< @brief Guards _pending and _stopping.
+    std::condition_variable _wakeup;            ///< @brief Signals a pending snapshot or shutdown.
+    std::optional<MetricsSnapshot> _pending;    ///< @brief Snapshot waiting to be exported.
+    bool _stopping{false};                      ///< @brief Set when the exporter is shutting down.
+
+    std::thread _thread;                        ///< @brief Thread serializing and writing snapshots.
+
+    // Private Methods
+
+    /// @brief Exporter thread loop.
+    void Run();
+
+    /// @brief Writes a payload to the configured destination.
+    /// @param payload Serialized snapshot.
+    /// @return True if the payload was written.
+    bool TryWrite(const std::string& payload) const;
+
+    /// @brief Atomically replaces the target file with the payload.
+    bool TryWriteFile(const std::string& payload) const;
+
+    /// @brief Sends the payload over a new Unix-domain socket connection.
+    bool TryWriteSocket(const std::string& payload) const;
+};
+
+} // namespace velecs::ecs
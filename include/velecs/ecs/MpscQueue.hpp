@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace velecs::ecs {
+
+/// @class MpscQueue
+/// @brief Bounded lock-free queue with many producers and a single consumer.
+/// @tparam T The type of value stored in the queue.
+///
+/// Each slot carries a sequence number that tells producers and the consumer whether the
+/// slot is free or holds a published value, so producers only contend on a single atomic
+/// position and never take a lock. The capacity is fixed at construction and rounded up to
+/// a power of two; TryPush() fails instead of growing when the queue is full.
+///
+/// Any thread may call TryPush(). Only one thread at a time may call TryPop().
+template<typename T>
+class MpscQueue {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a queue able to hold at least the given number of values.
+    /// @param capacity Minimum capacity, rounded up to the next power of two.
+    explicit MpscQueue(const size_t capacity)
+    {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+
+        _mask = rounded - 1;
+        _cells = std::make_unique<Cell[]>(rounded);
+        for (size_t i = 0; i < rounded; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Deleted default constructor.
+    MpscQueue() = delete;
+
+    /// @brief Default destructor.
+    ~MpscQueue() = default;
+
+    // Delete copy and move operations since producers may hold a reference
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    // Public Methods
+
+    /// @brief Attempts to append a value. Safe to call from any thread.
+    /// @param value The value to append. Only moved from if the push succeeds.
+    /// @return True if the value was queued, false if the queue is full.
+    bool TryPush(T&& value)
+    {
+        Cell* cell{nullptr};
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                // Slot is free for this position, try to claim it
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0)
+            {
+                // Slot still holds a value from the previous lap
+                return false;
+            }
+            else
+            {
+                // Another producer claimed this position first
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Attempts to remove the oldest value. Single consumer only.
+    /// @param outValue Receives the value if one was available.
+    /// @return True if a value was removed, false if the queue is empty.
+    bool TryPop(T& outValue)
+    {
+        Cell& cell = _cells[_dequeuePos & _mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(_dequeuePos + 1);
+
+        // Nothing has been published in this slot yet
+        if (diff < 0) return false;
+
+        assert(cell.value.has_value() && "Published slot must hold a value");
+        outValue = std::move(*cell.value);
+        cell.value.reset();
+        cell.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+        ++_dequeuePos;
+        return true;
+    }
+
+    /// @brief Gets the number of values the queue can hold.
+    /// @return The power-of-two capacity.
+    inline size_t GetCapacity() const { return _mask + 1; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    /// @brief A slot in the ring buffer.
+    struct Cell {
+        std::atomic<size_t> sequence{0}; ///< @brief Publication state of the slot.
+        std::optional<T> value;          ///< @brief The stored value, if published.
+    };
+
+    // Private Fields
+
+    std::unique_ptr<Cell[]> _cells; ///< @brief Ring buffer of slots.
+    size_t _mask{0};                ///< @brief Capacity minus one, used to wrap positions.
+
+    alignas(64) std::atomic<size_t> _enqueuePos{0}; ///< @brief Next position claimed by producers.
+    alignas(64) size_t _dequeuePos{0};              ///< @brief Next position read by the consumer.
+
+    // Private Methods
+};
+
+} // namespace velecs::ecs
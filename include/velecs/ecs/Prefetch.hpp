@@ -0,0 +1,13 @@
+#pragma once
+
+/// @brief Asks the CPU to start loading the cache line holding addr.
+/// @details Only a hint: it never faults, so it is safe on any pointer the caller is about to
+///          dereference. Compiles to nothing on compilers without a prefetch intrinsic.
+#if defined(__GNUC__) || defined(__clang__)
+#define VELECS_ECS_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define VELECS_ECS_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define VELECS_ECS_PREFETCH(addr) ((void)(addr))
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace velecs::ecs {
+
+/// @struct QuerySignature
+/// @brief Lists the tags and components a query requires.
+/// @tparam ComponentTypes The required tags and components.
+template<typename... ComponentTypes>
+struct QuerySignature {};
+
+/// @struct Exclude
+/// @brief Lists the tags and components a query rejects.
+/// @tparam ComponentTypes The rejected tags and components.
+template<typename... ComponentTypes>
+struct Exclude {};
+
+} // namespace velecs::ecs
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace velecs::ecs {
+
+/// @class RelationIndex
+/// @brief Forward and reverse edges of one relation kind between the entities of a scene.
+///
+/// Both directions are kept in EnTT storages keyed by entity: one sparse lookup finds an
+/// entity's edge list, and the lists themselves sit in a dense array. Adding, removing and
+/// listing the edges of an entity is therefore O(degree) in either direction, and an entity's
+/// edges can be dropped without scanning the others.
+///
+/// Scenes own one index per relation kind, see Scene::TryAddRelation().
+class RelationIndex {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RelationIndex() = default;
+
+    /// @brief Default deconstructor.
+    ~RelationIndex() = default;
+
+    // Public Methods
+
+    /// @brief Adds the edge source -> target.
+    /// @return True if added, false if it already existed.
+    bool TryAdd(const entt::entity source, const entt::entity target);
+
+    /// @brief Removes the edge source -> target.
+    /// @return True if removed, false if it did not exist.
+    bool TryRemove(const entt::entity source, const entt::entity target);
+
+    /// @brief Checks whether the edge source -> target exists.
+    bool Contains(const entt::entity source, const entt::entity target) const;
+
+    /// @brief Gets the entities a source points at, in no particular order.
+    /// @return Reference valid until the index is next modified.
+    const std::vector<entt::entity>& GetTargets(const entt::entity source) const;
+
+    /// @brief Gets the entities pointing at a target, in no particular order.
+    /// @return Reference valid until the index is next modified.
+    const std::vector<entt::entity>& GetSources(const entt::entity target) const;
+
+    /// @brief Removes every edge starting or ending at an entity.
+    /// @return Number of edges removed.
+    size_t Release(const entt::entity entity);
+
+    /// @brief Gets the number of edges in the index.
+    inline size_t GetEdgeCount() const { return _edgeCount; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    using Edges = std::vector<entt::entity>;
+
+    entt::storage<Edges> _targets; ///< @brief Outgoing edges, keyed by source.
+    entt::storage<Edges> _sources; ///< @brief Incoming edges, keyed by target.
+    size_t _edgeCount{0};          ///< @brief Number of edges.
+
+    // Private Methods
+
+    /// @brief Removes one entity from an edge list, dropping the list once it is empty.
+    /// @return True if the entity was in the list.
+    static bool TryErase(entt::storage<Edges>& lists, const entt::entity owner, const entt::entity entity);
+
+    /// @brief Gets a shared empty list for entities without edges.
+    static const Edges& GetEmpty();
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "velecs/ecs/Simd.hpp"
+
+#include <velecs/math/Vec3.hpp>
+#include <velecs/math/Quat.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Transform;
+
+/// @class RotationBatch
+/// @brief Runs quaternion maintenance over many Transforms at once.
+///
+/// The rotations are gathered into one array per quaternion component, so the kernels process
+/// four transforms per SSE instruction instead of one quaternion at a time. Each kernel flags
+/// the lanes it really changed, and Apply() only writes those back, so untouched transforms
+/// keep their cached matrices.
+///
+/// Scene::NormalizeRotations(), IntegrateRotations() and SlerpRotations() fill a batch from
+/// the Transform pool. Build one by hand to run a kernel over an arbitrary set of transforms:
+/// @code
+/// RotationBatch batch;
+/// for (Entity* wheel : wheels) batch.Add(&wheel->GetTransform(), spinOf(wheel));
+/// batch.Integrate(deltaTime);
+/// batch.Apply();
+/// @endcode
+class RotationBatch {
+public:
+    using Vec3 = velecs::math::Vec3;
+    using Quat = velecs::math::Quat;
+
+    // Public Fields
+
+    /// @brief Squared length error NormalizeRotations() tolerates before renormalizing.
+    static const float DEFAULT_TOLERANCE;
+
+    /// @brief A slerp whose target is at least this close (quaternion dot product) is skipped.
+    static const float SLERP_THRESHOLD;
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RotationBatch() = default;
+
+    /// @brief Default deconstructor.
+    ~RotationBatch() = default;
+
+    // Public Methods
+
+    /// @brief Adds a transform for Normalize().
+    /// @param transform The transform to maintain. Must stay alive until Apply().
+    void Add(Transform* const transform);
+
+    /// @brief Adds a transform for Integrate().
+    /// @param transform The transform to maintain. Must stay alive until Apply().
+    /// @param angularVelocity World space angular velocity, in radians per second.
+    void Add(Transform* const transform, const Vec3& angularVelocity);
+
+    /// @brief Adds a transform for Slerp().
+    /// @param transform The transform to maintain. Must stay alive until Apply().
+    /// @param target The rotation to move towards.
+    void Add(Transform* const transform, const Quat& target);
+
+    /// @brief Gets the number of transforms in the batch.
+    inline size_t GetSize() const { return _transforms.size(); }
+
+    /// @brief Chooses between the SSE kernels and their scalar fallbacks.
+    /// @param enabled False to run the scalar kernels, e.g. to compare them with the SSE ones.
+    /// @details Ignored on targets without SSE, which always run the scalar kernels.
+    inline void SetSimdEnabled(const bool enabled) { _simdEnabled = enabled && VELECS_ECS_SSE; }
+
+    /// @brief Checks whether the kernels run on SSE.
+    inline bool IsSimdEnabled() const { return _simdEnabled; }
+
+    /// @brief Renormalizes rotations whose squared length drifted from one.
+    /// @param tolerance Largest tolerated difference between the squared length and one.
+    /// @details Zero-length rotations cannot be normalized and are left alone.
+    void Normalize(const float tolerance = DEFAULT_TOLERANCE);
+
+    /// @brief Rotates every transform by its angular velocity over a time step.
+    /// @param deltaTime Length of the step, in seconds.
+    /// @details First-order integration followed by a renormalization. Transforms with a zero
+    ///          angular velocity are not changed.
+    void Integrate(const float deltaTime);
+
+    /// @brief Moves every rotation part of the way towards its target along the shortest arc.
+    /// @param t Fraction of the remaining angle to cover, 0 to 1.
+    /// @details Rotations within SLERP_THRESHOLD of their target, and every rotation when t
+    ///          is zero, are not changed. Nearly parallel pairs fall back to a normalized lerp.
+    void Slerp(const float t);
+
+    /// @brief Writes changed rotations back and marks those transforms dirty.
+    /// @return Number of transforms written.
+    /// @details Empties the batch, so it can be refilled.
+    size_t Apply();
+
+    /// @brief Empties the batch without writing anything back.
+    void Clear();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<Transform*> _transforms; ///< @brief Transforms in lane order.
+
+    std::vector<float> _x; ///< @brief Rotation x components, padded to a multiple of four lanes.
+    std::vector<float> _y; ///< @brief Rotation y components.
+    std::vector<float> _z; ///< @brief Rotation z components.
+    std::vector<float> _w; ///< @brief Rotation w components.
+
+    std::vector<float> _operandX; ///< @brief Angular velocity or target x components.
+    std::vector<float> _operandY; ///< @brief Angular velocity or target y components.
+    std::vector<float> _operandZ; ///< @brief Angular velocity or target z components.
+    std::vector<float> _operandW; ///< @brief Target w components, zero for angular velocities.
+
+    std::vector<uint8_t> _changed; ///< @brief Whether a kernel changed each lane.
+
+    bool _simdEnabled{VELECS_ECS_SSE != 0}; ///< @brief Whether the kernels run on SSE.
+
+    // Private Methods
+
+    /// @brief Appends one lane.
+    void Push(Transform* const transform, const float x, const float y, const float z, const float w);
+
+    /// @brief Pads every lane array to a multiple of four with identity rotations and zero operands.
+    /// @return Number of lanes including the padding.
+    size_t Pad();
+};
+
+} // namespace velecs::ecs
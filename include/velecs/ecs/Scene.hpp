@@ -1,6 +1,20 @@
 #pragma once
 
+#include "velecs/ecs/BinaryStream.hpp"
+#include "velecs/ecs/ColdStore.hpp"
+#include "velecs/ecs/CommandBuffer.hpp"
+#include "velecs/ecs/EventChannel.hpp"
+#include "velecs/ecs/MpscQueue.hpp"
 #include "velecs/ecs/Object.hpp"
+#include "velecs/ecs/Prefetch.hpp"
+#include "velecs/ecs/QuerySignature.hpp"
+#include "velecs/ecs/RelationIndex.hpp"
+#include "velecs/ecs/RotationBatch.hpp"
+#include "velecs/ecs/SceneCommand.hpp"
+#include "velecs/ecs/SceneCompaction.hpp"
+#include "velecs/ecs/SceneReleaser.hpp"
+#include "velecs/ecs/SceneStats.hpp"
+#include "velecs/ecs/StateHasher.hpp"
 #include "velecs/ecs/Tags/DestroyTag.hpp"
 #include "velecs/ecs/TypeConstraints.hpp"
 
@@ -9,6 +23,8 @@ using velecs::common::Context;
 
 #include <entt/entt.hpp>
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <deque>
 #include <iostream>
@@ -22,6 +38,15 @@ class Entity;
 class EntityBuilder;
 class Component;
 class System;
+class Transform;
+class EntityReservation;
+class WorldPartition;
+class SceneJournal;
+struct MetricsSnapshot;
+template<typename ComponentType> class StagedComponents;
+template<typename TagType> class StagedTags;
+class CachedQueryBase;
+template<typename Signature, typename Excluded> class CachedQuery;
 
 /// @class Scene
 /// @brief Represents a self-contained game scene with its own entity registry and lifecycle management.
@@ -34,6 +59,14 @@ class System;
 /// modular game architecture.
 class Scene : public Object {
     friend class SceneManager;
+    friend class Transform; // Records hot-path counters
+    template<typename> friend class StagedComponents; // Commits staged spawn components
+    template<typename> friend class StagedTags;       // Commits staged spawn tags
+    friend class WorldPartition;                      // Streams cells in and out in bulk
+    friend class SceneJournal;                        // Replays recorded component writes
+    template<typename, typename...> friend class FusedSystem; // Resolves entities in its fused loop
+    template<typename, typename> friend class SortedQuery;    // Listens to key pool signals
+    template<typename, typename> friend class CachedQuery;    // Listens to pool signals, resolves entities
 
 private:
     /// @brief ID for a System
@@ -49,6 +82,19 @@ public:
     ///          during typical system registration.
     static const size_t DEFAULT_SYSTEM_CAPACITY = 128;
 
+    /// @brief Capacity of the cross-thread command queue.
+    /// @details Producers fail to enqueue once this many commands are waiting to be drained.
+    static const size_t COMMAND_QUEUE_CAPACITY = 4096;
+
+    /// @brief Default number of entities per parallel query chunk.
+    static const size_t DEFAULT_PARALLEL_CHUNK_SIZE = 256;
+
+    /// @brief Number of matches multi-component queries prefetch ahead of the callback.
+    /// @details By the time the callback reaches an entity, the random accesses into the
+    ///          non-driving pools have landed. Only addresses are computed ahead, so callbacks
+    ///          follow the same rules as with a plain view.
+    static const size_t QUERY_PREFETCH_DISTANCE = 8;
+
     // Constructors and Destructors
 
     /// @brief Constructor for scene creation with custom system capacity.
@@ -113,6 +159,145 @@ public:
 
 
 
+    // ========== Cross-Thread Commands ==========
+
+
+
+    /// @brief Requests an entity spawn from any thread.
+    /// @param init Optional callback run on the frame thread with the newly created entity.
+    /// @return True if the command was queued, false if the command queue is full.
+    /// @details Lock-free. Commands are drained in bulk at the start of
+    ///          SceneManager::Internal_TryProcess(), before any system runs.
+    bool TryEnqueueSpawn(std::function<void(Entity* const)> init = {});
+
+    /// @brief Requests an entity's destruction from any thread.
+    /// @param uuid UUID of the entity to destroy.
+    /// @return True if the command was queued, false if the command queue is full.
+    /// @details Lock-free. When drained, the entity is marked for destruction and removed
+    ///          during the frame's cleanup phase like any other marked entity.
+    bool TryEnqueueDestroy(const Uuid& uuid);
+
+    /// @brief Requests a change to an entity from any thread.
+    /// @param uuid UUID of the entity to change.
+    /// @param update Callback run on the frame thread with the entity, e.g. to add, remove
+    ///               or edit components.
+    /// @return True if the command was queued, false if the command queue is full.
+    /// @details Lock-free. The command is dropped if the entity no longer exists when drained.
+    bool TryEnqueueUpdate(const Uuid& uuid, std::function<void(Entity* const)> update);
+
+
+
+    // ========== Reserved Entities ==========
+
+
+
+    /// @brief Creates a block of entities up front so workers can build them in parallel.
+    /// @param count Number of entities to reserve.
+    /// @param stagingCount Number of staging buffers to hand out, usually one per worker.
+    /// @return The reservation holding the new entities and their staging buffers.
+    /// @details Frame thread only. Handles, Entity objects and Transforms are created in a
+    ///          single batch. Workers may then edit the reserved entities' transforms (but not
+    ///          their hierarchy) and stage other components through their own SpawnStaging.
+    ///          Reserved entities are live immediately and visible to queries with only a
+    ///          Transform until the reservation is committed.
+    EntityReservation ReserveEntities(const size_t count, const size_t stagingCount = 1);
+
+    /// @brief Merges every staged component and tag of a reservation into the registry.
+    /// @param reservation The reservation to commit. Workers must be done staging.
+    /// @return Number of staged components and tags merged.
+    /// @details Frame thread only. Staging buffers are merged in index order, one reserved
+    ///          batch per staged type, so the resulting pool layout does not depend on which
+    ///          worker finished first. Committing twice does nothing.
+    size_t CommitReservation(EntityReservation& reservation);
+
+
+
+    // ========== Hibernation ==========
+
+
+
+    /// @brief Moves an entity and its whole Transform subtree out of the live registry.
+    /// @param root The subtree root to hibernate.
+    /// @return True if the subtree was hibernated, false if the root is not a valid entity of this scene.
+    /// @details Every component is frozen into a compact cold record: types with a codec are
+    ///          serialized, others are moved out of their pools. The handles are released, so
+    ///          queries no longer visit the subtree and pools only hold active content. The
+    ///          Entity objects stay alive (invalid until woken) so held pointers and UUIDs keep
+    ///          working. Components of types unknown to ComponentRegistry are dropped with a
+    ///          warning.
+    bool TryHibernate(Entity* const root);
+
+    /// @brief Restores a hibernated subtree into the live registry.
+    /// @param root UUID of the hibernated subtree root.
+    /// @param outRoot Set to the restored root entity, or nullptr on failure.
+    /// @return True if the subtree was restored, false if no subtree is hibernated under that UUID.
+    /// @details Entities receive new handles. The hierarchy is rebuilt and the root rejoins its
+    ///          former parent at its former sibling index if that parent is still alive, or
+    ///          becomes a root otherwise.
+    /// @throws std::runtime_error if the hibernated data is corrupt. The whole subtree is checked
+    ///         before anything is restored, so the scene and the subtree are left untouched.
+    bool TryWake(const Uuid& root, Entity*& outRoot);
+
+    /// @brief Checks whether a subtree is hibernated under the given root UUID.
+    /// @param root UUID of the subtree root.
+    inline bool IsHibernated(const Uuid& root) const { return _hibernated.find(root) != _hibernated.end(); }
+
+    /// @brief Gets the number of hibernated entities across all subtrees.
+    inline size_t GetHibernatedCount() const { return _hibernatedCount; }
+
+
+
+    // ========== Pool Warm-Up ==========
+
+
+
+    /// @brief Declares a component or tag type the scene uses, so its pool is built at load time.
+    /// @tparam ComponentType The component or tag type.
+    /// @param capacity Number of instances to pre-size the pool for.
+    /// @details EnTT creates pools lazily, so the first TryAddComponent<T>() or Query<T>() would
+    ///          otherwise pay for construction and initial growth mid-frame. Declared pools are
+    ///          created and reserved by Init() before OnEnter() on every activation. Declaring
+    ///          while the scene is active warms the pool immediately, so OnEnter() is a fine place
+    ///          too. Declaring a type again keeps the larger capacity.
+    template<typename ComponentType, typename = IsTagOrComponent<ComponentType>>
+    void DeclareComponent(const size_t capacity = 0);
+
+    /// @brief Gets the number of declared component and tag types.
+    inline size_t GetDeclaredComponentCount() const { return _declaredPools.size(); }
+
+    /// @brief Gets how many instances of a type the scene's pool holds before it has to grow.
+    /// @tparam ComponentType The component or tag type.
+    /// @return The pool's capacity, or zero if the pool has not been created yet.
+    template<typename ComponentType, typename = IsTagOrComponent<ComponentType>>
+    size_t GetPoolCapacity() const;
+
+
+
+    // ========== Compaction ==========
+
+
+
+    /// @brief Gives memory left behind by destroyed entities back to the allocator.
+    /// @return What was released.
+    /// @details Pools, the scene's entity map and the World's object maps keep their peak
+    ///          capacity after a mass despawn, and pools using in-place deletion keep the holes
+    ///          that iteration strides over. This releases the Entity objects of entities
+    ///          destroyed since the last compaction, fills the holes of every pool and shrinks
+    ///          every container to fit, except that declared pools keep their declared
+    ///          capacity. Pointers to components may change and pointers to destroyed entities
+    ///          dangle afterwards. Cost is linear in the size of the scene, so call it at a
+    ///          quiet moment or let the CompactionPolicy decide.
+    CompactionReport Compact();
+
+    /// @brief Sets the thresholds that make entity cleanup call Compact() on its own.
+    /// @param policy The policy to apply. Disabled by default.
+    inline void SetCompactionPolicy(const CompactionPolicy& policy) { _compactionPolicy = policy; }
+
+    /// @brief Gets the automatic compaction thresholds.
+    inline const CompactionPolicy& GetCompactionPolicy() const { return _compactionPolicy; }
+
+
+
     // ========== Tag Management ==========
 
 
@@ -226,6 +411,214 @@ public:
     
 
 
+    // ========== Bulk Operations ==========
+
+
+
+    /// @brief Adds a component to many entities with one pool insert.
+    /// @tparam ComponentType The component type to add.
+    /// @param entities Valid entities of this scene, without duplicates.
+    /// @param value Value copied into every new component.
+    /// @return Number of components added. Entities that already have one are skipped.
+    /// @details Skips the per-entity validity checks of TryAddComponent(); passing a destroyed
+    ///          entity or one of another scene is undefined, and only asserted in debug builds.
+    template<typename ComponentType, typename = IsComponent<ComponentType>>
+    size_t AddComponents(const std::vector<Entity*>& entities, const ComponentType& value = ComponentType{});
+
+    /// @brief Adds a component to every entity matching a query, with one pool insert.
+    /// @tparam ComponentType The component type to add.
+    /// @tparam QueryTypes The tags and components an entity needs to receive it. At least one.
+    /// @param value Value copied into every new component.
+    /// @return Number of components added. Matches that already have one are skipped.
+    template<typename ComponentType, typename... QueryTypes>
+    size_t AddComponentsWhere(const ComponentType& value = ComponentType{});
+
+    /// @brief Overwrites a component on many entities.
+    /// @tparam ComponentType The component type to overwrite.
+    /// @param entities Valid entities of this scene.
+    /// @param value Value copied over every existing component. Owners are kept.
+    /// @return Number of components overwritten. Entities without one are skipped.
+    template<typename ComponentType, typename = IsComponent<ComponentType>>
+    size_t ReplaceComponents(const std::vector<Entity*>& entities, const ComponentType& value);
+
+    /// @brief Overwrites a component on every entity that has it and matches a query.
+    /// @tparam ComponentType The component type to overwrite.
+    /// @tparam QueryTypes Additional tags and components an entity needs. May be empty, must not
+    ///         repeat ComponentType.
+    /// @param value Value copied over every matching component. Owners are kept.
+    /// @return Number of components overwritten.
+    template<typename ComponentType, typename... QueryTypes>
+    size_t ReplaceComponentsWhere(const ComponentType& value);
+
+    /// @brief Removes a component or tag from many entities with one pool removal.
+    /// @tparam TagOrComponent The tag or component type to remove.
+    /// @param entities Valid entities of this scene.
+    /// @return Number of components or tags removed. Entities without one are skipped.
+    template<typename TagOrComponent, typename = IsTagOrComponent<TagOrComponent>>
+    size_t RemoveComponents(const std::vector<Entity*>& entities);
+
+    /// @brief Removes a component or tag from every entity that has it and matches a query.
+    /// @tparam TagOrComponent The tag or component type to remove.
+    /// @tparam QueryTypes Additional tags and components an entity needs. May be empty to clear
+    ///         the whole pool, must not repeat TagOrComponent.
+    /// @return Number of components or tags removed.
+    template<typename TagOrComponent, typename... QueryTypes>
+    size_t RemoveComponentsWhere();
+
+    /// @brief Adds a tag to many entities with one pool insert.
+    /// @tparam TagType The tag type to add.
+    /// @param entities Valid entities of this scene, without duplicates.
+    /// @return Number of tags added. Entities that already have it are skipped.
+    template<typename TagType, typename = IsTag<TagType>>
+    size_t AddTags(const std::vector<Entity*>& entities);
+
+    /// @brief Adds a tag to every entity matching a query, with one pool insert.
+    /// @tparam TagType The tag type to add.
+    /// @tparam QueryTypes The tags and components an entity needs to receive it. At least one.
+    /// @return Number of tags added. Matches that already have it are skipped.
+    template<typename TagType, typename... QueryTypes>
+    size_t AddTagsWhere();
+
+
+
+    // ========== Rotation Maintenance ==========
+
+
+
+    /// @brief Renormalizes every Transform rotation that drifted from unit length.
+    /// @tparam QueryTypes Tags and components an entity needs to be included. May be empty to
+    ///         cover the whole Transform pool.
+    /// @param tolerance Largest tolerated difference between the squared length and one.
+    /// @return Number of transforms renormalized and marked dirty.
+    template<typename... QueryTypes>
+    size_t NormalizeRotations(const float tolerance = RotationBatch::DEFAULT_TOLERANCE);
+
+    /// @brief Rotates every Transform by an angular velocity stored in another component.
+    /// @tparam Source The component holding the angular velocity.
+    /// @tparam QueryTypes Additional tags and components an entity needs.
+    /// @param deltaTime Length of the step, in seconds.
+    /// @param angularVelocity Member of Source holding the world space angular velocity, in
+    ///        radians per second.
+    /// @return Number of transforms rotated and marked dirty. Zero velocities are skipped.
+    template<typename Source, typename... QueryTypes>
+    size_t IntegrateRotations(const float deltaTime, math::Vec3 Source::* const angularVelocity);
+
+    /// @brief Moves every Transform rotation towards a target stored in another component.
+    /// @tparam Source The component holding the target rotation.
+    /// @tparam QueryTypes Additional tags and components an entity needs.
+    /// @param t Fraction of the remaining angle to cover, 0 to 1.
+    /// @param target Member of Source holding the target rotation.
+    /// @return Number of transforms rotated and marked dirty. Rotations already at their
+    ///         target are skipped.
+    template<typename Source, typename... QueryTypes>
+    size_t SlerpRotations(const float t, math::Quat Source::* const target);
+
+
+
+    // ========== Relations ==========
+
+
+
+    /// @brief Links two entities with a relation of the given kind.
+    /// @tparam Kind Any type naming the relation, e.g. `struct Targets {};`. Each kind is
+    ///         indexed separately.
+    /// @param source The entity the relation starts at.
+    /// @param target The entity the relation points at. May be the source itself.
+    /// @return True if the relation was added, false if it already existed or an entity is
+    ///         invalid or belongs to another scene.
+    /// @details Relations are indexed in both directions and dropped automatically when either
+    ///          entity is destroyed or hibernated, so they never dangle.
+    template<typename Kind>
+    bool TryAddRelation(const Entity* const source, const Entity* const target);
+
+    /// @brief Unlinks two entities.
+    /// @tparam Kind The relation kind.
+    /// @return True if the relation existed and was removed.
+    template<typename Kind>
+    bool TryRemoveRelation(const Entity* const source, const Entity* const target);
+
+    /// @brief Checks whether source is linked to target.
+    /// @tparam Kind The relation kind.
+    template<typename Kind>
+    bool HasRelation(const Entity* const source, const Entity* const target) const;
+
+    /// @brief Gets the number of entities a source is linked to.
+    /// @tparam Kind The relation kind.
+    template<typename Kind>
+    size_t GetRelationTargetCount(const Entity* const source) const;
+
+    /// @brief Gets the number of entities linked to a target.
+    /// @tparam Kind The relation kind.
+    template<typename Kind>
+    size_t GetRelationSourceCount(const Entity* const target) const;
+
+    /// @brief Calls a function on every entity a source is linked to.
+    /// @tparam Kind The relation kind.
+    /// @param callback Called as callback(Entity* target), in no particular order.
+    /// @details O(number of targets). The callback must not add or remove relations of this
+    ///          kind; collect the entities first to do so.
+    template<typename Kind, typename Func>
+    void ForEachRelationTarget(const Entity* const source, Func&& callback);
+
+    /// @brief Calls a function on every entity linked to a target, e.g. "who targets me?".
+    /// @tparam Kind The relation kind.
+    /// @param callback Called as callback(Entity* source), in no particular order.
+    /// @details O(number of sources). The callback must not add or remove relations of this
+    ///          kind; collect the entities first to do so.
+    template<typename Kind, typename Func>
+    void ForEachRelationSource(const Entity* const target, Func&& callback);
+
+    /// @brief Removes every relation of a kind starting or ending at an entity.
+    /// @tparam Kind The relation kind.
+    /// @return Number of relations removed.
+    template<typename Kind>
+    size_t ClearRelations(const Entity* const entity);
+
+
+
+    // ========== Cached Queries ==========
+
+
+
+    /// @brief Creates a query whose matches are kept in a dense array across frames.
+    /// @tparam Signature A QuerySignature listing the tags and components a match must own.
+    /// @tparam Excluded An Exclude listing the tags and components a match must not own.
+    /// @param filter Optional extra check, such as a relation, called as filter(Entity*).
+    /// @return The query, owned by the scene until TryDestroyCachedQuery() or the scene exits.
+    /// @details Matches are updated from the pools' add and remove signals, so iterating the
+    ///          query walks an array instead of re-testing the filter. See CachedQuery.
+    ///          The scene must be initialized, e.g. create queries in OnEnter().
+    template<typename Signature, typename Excluded = Exclude<>>
+    CachedQuery<Signature, Excluded>* CreateCachedQuery(std::function<bool(Entity*)> filter = {});
+
+    /// @brief Destroys a query created by CreateCachedQuery().
+    /// @param query The query to destroy.
+    /// @return True if the query belonged to this scene and was destroyed.
+    bool TryDestroyCachedQuery(const CachedQueryBase* const query);
+
+    /// @brief Gets the number of cached queries the scene owns.
+    inline size_t GetCachedQueryCount() const { return _cachedQueries.size(); }
+
+
+
+    // ========== Events ==========
+
+
+
+    /// @brief Gets the scene's channel for an event type, creating it on first use.
+    /// @tparam EventType The event, any movable type.
+    /// @return The channel, valid until the scene exits.
+    /// @details Events sent during a frame are readable during the next one, see EventChannel.
+    ///          The first call for a type must happen on the frame thread, e.g. in OnEnter();
+    ///          afterwards pool tasks may look the channel up and send to it concurrently.
+    template<typename EventType>
+    EventChannel<EventType>& GetEventChannel();
+
+    /// @brief Gets the number of event channels the scene owns.
+    inline size_t GetEventChannelCount() const { return _eventChannels.size(); }
+
+
+
     // ========== System Management ==========
 
 
@@ -291,6 +684,119 @@ public:
     template<typename... TagsOrComponents>
     void Query(std::function<void(Entity*, TagsOrComponents&...)> callback);
 
+
+
+    // ========== Parallel Execution ==========
+
+
+
+    /// @brief Runs a callback over every entity with the given components on the worker pool.
+    /// @tparam ComponentTypes The components to query. Tags are not supported.
+    /// @param callback Called as callback(CommandBuffer&, Entity*, ComponentTypes&...).
+    /// @details The matching entities are split into contiguous chunks, each with its own
+    ///          CommandBuffer. The callback may only modify the components it receives;
+    ///          spawns, destruction, component changes and reparenting must be recorded into
+    ///          the buffer. Buffers are applied in chunk order once every chunk is done, so
+    ///          the results match a serial run of the same query.
+    template<typename... ComponentTypes, typename Func>
+    void ParallelQuery(Func&& callback);
+
+    /// @brief Recomputes every dirty world matrix on the worker pool.
+    /// @return Number of world matrices recomputed.
+    /// @details World matrices are otherwise computed lazily, one entity at a time, on whichever
+    ///          thread asks first. Every dirty subtree under a clean parent (or under no parent)
+    ///          is independent of the others, so they are sized in parallel, balanced across
+    ///          the pool threads largest first, and propagated top down without locking. Call
+    ///          it on the frame thread once simulation is done moving transforms, e.g. before
+    ///          rendering. A single huge subtree is not split and stays on one thread.
+    size_t PropagateTransforms();
+
+    /// @brief Applies and clears the commands recorded in a buffer.
+    /// @param buffer The buffer to apply. Frame thread only.
+    void ApplyCommands(CommandBuffer& buffer);
+
+    /// @brief Enables or disables deterministic parallel execution.
+    /// @param deterministic True to partition parallel queries independently of the thread count.
+    /// @details In deterministic mode every parallel query is cut into chunks of exactly
+    ///          GetParallelChunkSize() entities, so chunk indices (and anything seeded from
+    ///          them) are identical on every machine. Otherwise chunks are sized to the worker
+    ///          pool to keep scheduling overhead low. Commands queued from other threads with
+    ///          TryEnqueueSpawn() and friends still apply in arrival order and are not suitable
+    ///          for lockstep simulation.
+    inline void SetDeterministic(const bool deterministic) { _deterministic = deterministic; }
+
+    /// @brief Checks whether deterministic parallel execution is enabled.
+    inline bool IsDeterministic() const { return _deterministic; }
+
+    /// @brief Sets the number of entities per parallel query chunk.
+    /// @param chunkSize Entities per chunk. Must be greater than zero.
+    /// @details Exact chunk size in deterministic mode, minimum chunk size otherwise. Every
+    ///          peer in a lockstep session must use the same value.
+    inline void SetParallelChunkSize(const size_t chunkSize)
+    {
+        assert(chunkSize > 0 && "Parallel chunk size must be greater than zero");
+        _parallelChunkSize = chunkSize;
+    }
+
+    /// @brief Gets the number of entities per parallel query chunk.
+    inline size_t GetParallelChunkSize() const { return _parallelChunkSize; }
+
+
+
+    // ========== Statistics ==========
+
+
+
+    /// @brief Gets the hot-path counters accumulated so far in the current frame.
+    /// @return Snapshot of the running counters.
+    /// @details Counters are compiled out when VELECS_ECS_STATS_ENABLED is 0, in which case
+    ///          every value is zero.
+    SceneStats GetStats() const;
+
+    /// @brief Gets the hot-path counters of the last completed frame.
+    /// @return Snapshot taken at the end of the last entity cleanup phase.
+    /// @details Use this to spot frames where internal work spikes, e.g. a dirty propagation
+    ///          storm after a gameplay change.
+    inline const SceneStats& GetFrameStats() const { return _frameStats; }
+
+    /// @brief Resets the running counters of the current frame to zero.
+    void ResetStats();
+
+    /// @brief Gets the number of entities currently owned by this scene.
+    /// @return Number of live entities.
+    /// @details Destroyed entities awaiting compaction still have an entry but are not counted.
+    inline size_t GetEntityCount() const { return _entities.size() - _staleEntityCount; }
+
+    /// @brief Gets how many entities the last cleanup phase destroyed.
+    /// @return Number of entities destroyed, including descendants of marked entities.
+    inline uint64_t GetLastCleanupCount() const { return _lastCleanupCount; }
+
+    /// @brief Gets how many entities cleanup phases have destroyed since the scene was created.
+    /// @return Running total of destroyed entities.
+    inline uint64_t GetTotalCleanupCount() const { return _totalCleanupCount; }
+
+    /// @brief Fills the scene-specific parts of a metrics snapshot.
+    /// @param snapshot The snapshot to append this scene's metrics to.
+    /// @details Copies entity counts, component pool sizes, system timings, cleanup counts and
+    ///          the last frame's hot-path counters. Meant to be called from the frame thread at
+    ///          the exporter's interval, not every frame.
+    void CollectMetrics(MetricsSnapshot& snapshot) const;
+
+
+
+    // ========== State Hashing ==========
+
+
+
+    /// @brief Computes a fingerprint of the scene's registry state.
+    /// @return The combined hash plus one sub-hash per non-empty pool, sorted by type id.
+    /// @details Every pool contributes its entity handles in dense order, so membership and
+    ///          layout are covered for tags and components alike. Component values are only
+    ///          covered for types providing `void HashState(StateHasher&) const`; Transform
+    ///          does, which also covers the hierarchy. Compare StateHash::pools between two
+    ///          runs to find the first diverging type instead of diffing whole scenes.
+    StateHash ComputeStateHash() const;
+
 protected:
     // Protected Fields
 
@@ -309,8 +815,64 @@ private:
     /// @brief Map of system type indices to system instances for fast lookup and storage.
     std::unordered_map<SystemId, SystemStorage> _systems;
 
+    /// @brief Structural commands queued by other threads, drained on the frame thread.
+    std::unique_ptr<MpscQueue<SceneCommand>> _commands;
+
+    /// @brief Running hot-path counters for the current frame, indexed by SceneCounter.
+    /// @details Relaxed atomics so worker threads touching transforms can record safely.
+    mutable std::array<std::atomic<uint64_t>, static_cast<size_t>(SceneCounter::Count)> _counters{};
+    /// @brief Counters of the last completed frame.
+    SceneStats _frameStats;
+
+    uint64_t _lastCleanupCount{0};  ///< @brief Entities destroyed by the last cleanup phase.
+    uint64_t _totalCleanupCount{0}; ///< @brief Entities destroyed by all cleanup phases.
+
+    /// @brief Hibernated subtrees keyed by the UUID of their root.
+    std::unordered_map<Uuid, HibernatedSubtree> _hibernated;
+    size_t _hibernatedCount{0}; ///< @brief Number of hibernated entities across all subtrees.
+
+    /// @brief A pool to build when the registry is created.
+    struct PoolDeclaration {
+        entt::id_type id;                                       ///< @brief EnTT type id of the pool.
+        size_t capacity;                                        ///< @brief Instances to reserve.
+        void (*warm)(entt::registry& registry, const size_t capacity); ///< @brief Creates and reserves the pool.
+    };
+
+    /// @brief Pools declared through DeclareComponent(), in declaration order.
+    std::vector<PoolDeclaration> _declaredPools;
+
+    /// @brief Relation indices keyed by relation kind, created on first use.
+    std::unordered_map<std::type_index, RelationIndex> _relations;
+
+    /// @brief Queries created through CreateCachedQuery(), dropped before the registry.
+    std::vector<std::unique_ptr<CachedQueryBase>> _cachedQueries;
+
+    /// @brief An event channel of any type, swapped and destroyed through plain function pointers.
+    struct EventChannelSlot {
+        std::unique_ptr<void, void (*)(void*)> channel{nullptr, nullptr}; ///< @brief The EventChannel.
+        void (*swap)(void* channel){nullptr};                             ///< @brief Calls EventChannel::Swap().
+    };
+
+    /// @brief Event channels keyed by event type, created on first use.
+    std::unordered_map<std::type_index, EventChannelSlot> _eventChannels;
+
+    CompactionPolicy _compactionPolicy; ///< @brief When cleanup compacts on its own.
+    size_t _staleEntityCount{0};        ///< @brief Destroyed entities still in _entities, since the last compaction.
+
+    bool _deterministic{false};                               ///< @brief Whether parallel chunking ignores the thread count.
+    size_t _parallelChunkSize{DEFAULT_PARALLEL_CHUNK_SIZE};   ///< @brief Entities per parallel query chunk.
+
     // Private Methods
 
+    /// @brief Adds to one of the scene's hot-path counters.
+    /// @param counter The counter to increment.
+    /// @param amount The amount to add.
+    /// @details Prefer the VELECS_ECS_COUNT macro so the call compiles out with the counters.
+    inline void IncrementCounter(const SceneCounter counter, const uint64_t amount = 1) const
+    {
+        _counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
     /// @brief Gets a reference to the scene's entity registry.
     /// @return Reference to the active EnTT registry.
     /// @throws std::runtime_error if the registry has not been initialized.
@@ -325,14 +887,19 @@ private:
     const entt::registry& GetRegistry() const;
 
     /// @brief Initializes the scene's entity registry and calls OnEnter().
-    /// @details Creates the EnTT registry for this scene and triggers the OnEnter()
-    ///          lifecycle method. Called automatically by SceneManager during scene transitions.
+    /// @details Creates the EnTT registry for this scene, warms every declared pool and triggers
+    ///          the OnEnter() lifecycle method. Called automatically by SceneManager during scene
+    ///          transitions.
     void Init(void* context);
 
     /// @brief Cleans up the scene's entity registry and calls OnExit().
-    /// @details Triggers the OnExit() lifecycle method, clears all entities from the registry,
-    ///          and resets the registry. Called automatically by SceneManager during scene transitions.
-    void Cleanup(void* context);
+    /// @param context Execution context data passed to OnExit().
+    /// @param releaser Background releaser receiving the detached state, or null to destroy it here.
+    /// @details Triggers the OnExit() lifecycle method, then removes the registry and the
+    ///          World-side object of every live, destroyed or hibernated entity of the scene, and
+    ///          destroys them here or on the releaser thread. Pointers to the scene's entities
+    ///          dangle afterwards. Called automatically by SceneManager during scene transitions.
+    void Cleanup(void* context, SceneReleaser* const releaser = nullptr);
     
     /// @brief Attempts to register a pre-constructed system instance with the scene.
     /// @tparam SystemType The type of system to add. Must inherit from System.
@@ -346,6 +913,122 @@ private:
     template<typename SystemType, typename = IsSystem<SystemType>>
     bool TryAddSystem(std::unique_ptr<SystemType> system);
 
+    /// @brief Inserts a batch of staged components into their pool.
+    /// @tparam ComponentType The staged component type.
+    /// @param owners Reserved entities receiving the components.
+    /// @param values Staged values, parallel to owners. Moved from.
+    template<typename ComponentType>
+    void CommitStaged(const std::vector<Entity*>& owners, std::vector<ComponentType>& values);
+
+    /// @brief Inserts a batch of staged tags into their pool.
+    /// @tparam TagType The staged tag type.
+    /// @param owners Reserved entities receiving the tag.
+    template<typename TagType>
+    void CommitStagedTags(const std::vector<Entity*>& owners);
+
+    /// @brief Runs a multi-component query, prefetching components ahead of the callback.
+    /// @param callback Called as callback(Entity*, TagsOrComponents&...) in view order.
+    /// @details A second view iterator runs QUERY_PREFETCH_DISTANCE matches ahead and prefetches
+    ///          their components, overlapping the cache misses with the callbacks in between. The
+    ///          callback gets references resolved for the current entity only, and the owner is
+    ///          read from the first component instead of looked up.
+    template<typename... TagsOrComponents, typename Func>
+    void PrefetchedQuery(Func& callback);
+
+    /// @brief Inserts one value for every owner in a single range insert and sets the owners.
+    /// @param storage The pool of the component type.
+    /// @param owners Entities that do not have the component yet, without duplicates.
+    /// @param value Value copied into every new component.
+    /// @return Number of components added.
+    template<typename ComponentType>
+    static size_t InsertComponents(entt::storage_for_t<ComponentType>& storage,
+        const std::vector<Entity*>& owners, const ComponentType& value);
+
+    /// @brief Creates the pool of a type and reserves room in it.
+    template<typename ComponentType>
+    static void WarmPool(entt::registry& registry, const size_t capacity);
+
+    /// @brief Gets the index of a relation kind, creating it on first use.
+    template<typename Kind>
+    RelationIndex& GetRelationIndex();
+
+    /// @brief Gets the index of a relation kind.
+    /// @return The index, or nullptr if no relation of the kind was ever added.
+    template<typename Kind>
+    const RelationIndex* TryGetRelationIndex() const;
+
+    /// @brief Drops every relation of every kind touching an entity about to be destroyed.
+    /// @param handle Handle of the entity. Must still be valid.
+    void ReleaseRelations(const entt::entity handle);
+
+    /// @brief Makes last frame's events readable in every channel. Called by the SceneManager.
+    void SwapEventChannels();
+
+    /// @brief Drains the cross-thread command queue and applies every command in order.
+    /// @return Number of commands drained.
+    /// @details At most one queue's worth of commands is drained per call, so commands
+    ///          queued by the callbacks themselves wait for the next frame.
+    size_t ProcessCommands();
+
+    /// @brief Creates entities without any components in one batch.
+    /// @param count Number of entities to create.
+    /// @return The new entities, in creation order.
+    /// @details Callers must give every entity a Transform before it is used.
+    std::vector<Entity*> CreateEntities(const size_t count);
+
+    /// @brief Destroys entities in one batch and releases their Entity objects from the World.
+    /// @param entities Entities to destroy. Must be whole subtrees whose roots have no parent.
+    /// @return Number of entities destroyed.
+    /// @details Pointers to the destroyed entities dangle afterwards.
+    size_t DestroyEntities(const std::vector<Entity*>& entities);
+
+    /// @brief Takes the registry and the World-side objects of every entity the scene created,
+    ///        live, destroyed or hibernated, out of the scene and the World.
+    /// @return The detached state, safe to destroy on any thread.
+    /// @details Pools of components that must be destroyed on the frame thread, and pools of types
+    ///          unknown to ComponentRegistry, are cleared first. Hibernated records are destroyed
+    ///          here.
+    DetachedScene Detach();
+
+    /// @brief Checks whether any container fell below the compaction policy's occupancy.
+    /// @details Capacity reserved through DeclareComponent() counts as in use.
+    bool IsCompactionDue() const;
+
+    /// @brief Gets the capacity a pool was declared with through DeclareComponent().
+    /// @param id EnTT type id of the pool.
+    /// @return The declared capacity, or zero if the type was not declared.
+    size_t GetDeclaredCapacity(const entt::id_type id) const;
+
+    /// @brief Freezes every component of an entity into a cold record.
+    /// @param handle The entity whose components to freeze. Pools are left untouched.
+    /// @param writer Receives the component count followed by each component's id, size and payload.
+    /// @param boxes Receives values of types without a codec, or null to drop those.
+    /// @return Number of components frozen.
+    uint32_t FreezeComponents(const entt::entity handle, BinaryWriter& writer, ColdBoxes* const boxes);
+
+    /// @brief Recreates the components written by FreezeComponents() on an entity.
+    /// @param entity The entity receiving the components. Must hold a live handle.
+    /// @param reader Positioned at the component count.
+    /// @param boxes The boxes passed to FreezeComponents(), or null.
+    /// @throws std::runtime_error if the record is corrupt.
+    void ThawComponents(Entity* const entity, BinaryReader& reader, ColdBoxes* const boxes);
+
+    /// @brief Checks that a hibernated subtree can be restored, without restoring anything.
+    /// @param subtree The subtree about to be woken.
+    /// @throws std::runtime_error if the data is truncated, a parent does not precede its child
+    ///         or an entity has no Transform.
+    void ValidateHibernated(const HibernatedSubtree& subtree) const;
+
+    /// @brief Gets the chunk size to use for a parallel query.
+    /// @param rowCount Number of entities matched by the query.
+    /// @param threadCount Number of threads available to run chunks.
+    /// @return Entities per chunk, never zero.
+    size_t GetChunkSize(const size_t rowCount, const size_t threadCount) const;
+
+    /// @brief Applies a single structural command.
+    /// @param command The command to apply.
+    void ExecuteCommand(SceneCommand& command);
+
     /// @brief Destroys a specific entity from this scene's registry.
     /// @param entity The entity to destroy.
     /// @details Immediately removes the entity and all its components from the registry.
@@ -375,7 +1058,8 @@ private:
 
     /// @brief Processes cleanup and entity destruction for this scene.
     /// @details Handles deferred entity destruction and system cleanup.
-    ///          Should be called at the end of each frame.
+    ///          Should be called at the end of each frame. Also snapshots the frame's
+    ///          hot-path counters into GetFrameStats() and resets them.
     void ProcessEntityCleanup();
 };
 
@@ -1,5 +1,11 @@
+#include "velecs/ecs/CachedQuery.hpp"
+#include "velecs/ecs/ComponentRegistry.hpp"
 #include "velecs/ecs/Entity.hpp"
 #include "velecs/ecs/System.hpp"
+#include "velecs/ecs/World.hpp"
+
+#include <algorithm>
+#include <tuple>
 
 namespace velecs::ecs {
 
@@ -19,6 +25,7 @@ template<typename TagType, typename>
 bool Scene::TryAddTag(Entity* const entity)
 {
     if (HasTag<TagType>(entity)) return false;
+    ComponentRegistry::Register<TagType>();
     GetRegistry().emplace<TagType>(entity->_handle);
     return true;
 }
@@ -67,6 +74,7 @@ bool Scene::TryAddComponent(Entity* const entity, ComponentType*& outComponent)
         return false;
     }
 
+    ComponentRegistry::Register<ComponentType>();
     ComponentType& comp = GetRegistry().emplace<ComponentType>(entity->_handle);
     comp._owner = entity;
     outComponent = &comp;
@@ -83,6 +91,7 @@ bool Scene::TryAddComponent(Entity* const entity, const ComponentType*& outCompo
         return false;
     }
 
+    ComponentRegistry::Register<ComponentType>();
     ComponentType& comp = GetRegistry().emplace<ComponentType>(entity->_handle);
     comp._owner = entity;
     outComponent = &comp;
@@ -99,6 +108,7 @@ bool Scene::TryAddComponent(Entity* const entity, ComponentType*& outComponent,
         return false;
     }
 
+    ComponentRegistry::Register<ComponentType>();
     ComponentType& comp = GetRegistry().emplace<ComponentType>(entity->_handle, std::forward<Args>(args)...);
     comp._owner = entity;
     outComponent = &comp;
@@ -115,6 +125,7 @@ bool Scene::TryAddComponent(Entity* const entity, const ComponentType*& outCompo
         return false;
     }
 
+    ComponentRegistry::Register<ComponentType>();
     ComponentType& comp = GetRegistry().emplace<ComponentType>(entity->_handle, std::forward<Args>(args)...);
     comp._owner = entity;
     outComponent = &comp;
@@ -130,6 +141,433 @@ bool Scene::TryRemoveComponent(Entity* const entity)
     return true;
 }
 
+// ========== Bulk Operations ==========
+
+
+
+template<typename ComponentType, typename>
+size_t Scene::AddComponents(const std::vector<Entity*>& entities, const ComponentType& value)
+{
+    static_assert(!std::is_same_v<ComponentType, Transform>,
+        "Entities already own a Transform, edit it through Entity::GetTransform().");
+
+    ComponentRegistry::Register<ComponentType>();
+    auto& storage = GetRegistry().storage<ComponentType>();
+
+    std::vector<Entity*> owners;
+    owners.reserve(entities.size());
+    for (Entity* const entity : entities)
+    {
+        assert(entity && entity->_scene == this && "Bulk operations only take entities of this scene");
+        if (!storage.contains(entity->_handle)) owners.push_back(entity);
+    }
+    return InsertComponents(storage, owners, value);
+}
+
+template<typename ComponentType, typename... QueryTypes>
+size_t Scene::AddComponentsWhere(const ComponentType& value)
+{
+    static_assert(std::is_base_of_v<Component, ComponentType>, "ComponentType must inherit from Component");
+    static_assert(!std::is_same_v<ComponentType, Transform>,
+        "Entities already own a Transform, edit it through Entity::GetTransform().");
+    static_assert(sizeof...(QueryTypes) > 0, "AddComponentsWhere needs at least one query type");
+
+    ComponentRegistry::Register<ComponentType>();
+    auto& storage = GetRegistry().storage<ComponentType>();
+
+    // Owners are resolved up front, inserting while the view is iterated could touch its pools
+    std::vector<Entity*> owners;
+    for (const entt::entity handle : GetRegistry().view<QueryTypes...>())
+    {
+        if (storage.contains(handle)) continue;
+        Entity* const entity = TryGetEntity(handle);
+        assert(entity && "Should always be able to lookup entity via entt handle");
+        owners.push_back(entity);
+    }
+    return InsertComponents(storage, owners, value);
+}
+
+template<typename ComponentType, typename>
+size_t Scene::ReplaceComponents(const std::vector<Entity*>& entities, const ComponentType& value)
+{
+    static_assert(!std::is_same_v<ComponentType, Transform>,
+        "Entities already own a Transform, edit it through Entity::GetTransform().");
+
+    auto& storage = GetRegistry().storage<ComponentType>();
+
+    size_t count = 0;
+    for (Entity* const entity : entities)
+    {
+        assert(entity && entity->_scene == this && "Bulk operations only take entities of this scene");
+        if (!storage.contains(entity->_handle)) continue;
+
+        ComponentType& comp = storage.get(entity->_handle);
+        comp = value;
+        comp._owner = entity;
+        ++count;
+    }
+    return count;
+}
+
+template<typename ComponentType, typename... QueryTypes>
+size_t Scene::ReplaceComponentsWhere(const ComponentType& value)
+{
+    static_assert(std::is_base_of_v<Component, ComponentType>, "ComponentType must inherit from Component");
+    static_assert(!std::is_same_v<ComponentType, Transform>,
+        "Entities already own a Transform, edit it through Entity::GetTransform().");
+
+    auto view = GetRegistry().view<ComponentType, QueryTypes...>();
+
+    size_t count = 0;
+    for (const entt::entity handle : view)
+    {
+        ComponentType& comp = view.template get<ComponentType>(handle);
+        Entity* const owner = comp._owner;
+        comp = value;
+        comp._owner = owner;
+        ++count;
+    }
+    return count;
+}
+
+template<typename TagOrComponent, typename>
+size_t Scene::RemoveComponents(const std::vector<Entity*>& entities)
+{
+    static_assert(!std::is_same_v<TagOrComponent, Transform>,
+        "Entities always own a Transform, it cannot be removed.");
+
+    std::vector<entt::entity> handles;
+    handles.reserve(entities.size());
+    for (Entity* const entity : entities)
+    {
+        assert(entity && entity->_scene == this && "Bulk operations only take entities of this scene");
+        handles.push_back(entity->_handle);
+    }
+    return GetRegistry().remove<TagOrComponent>(handles.begin(), handles.end());
+}
+
+template<typename TagOrComponent, typename... QueryTypes>
+size_t Scene::RemoveComponentsWhere()
+{
+    static_assert(std::is_base_of_v<Component, TagOrComponent> || std::is_base_of_v<Tag, TagOrComponent>,
+        "TagOrComponent must inherit from Tag or Component");
+    static_assert(!std::is_same_v<TagOrComponent, Transform>,
+        "Entities always own a Transform, it cannot be removed.");
+
+    entt::registry& registry = GetRegistry();
+    if constexpr (sizeof...(QueryTypes) == 0)
+    {
+        auto& storage = registry.storage<TagOrComponent>();
+        const size_t count = storage.size();
+        storage.clear();
+        return count;
+    }
+    else
+    {
+        // Removing from a pool the view iterates would skip entities, so collect first
+        auto view = registry.view<TagOrComponent, QueryTypes...>();
+        std::vector<entt::entity> handles(view.begin(), view.end());
+        return registry.remove<TagOrComponent>(handles.begin(), handles.end());
+    }
+}
+
+template<typename TagType, typename>
+size_t Scene::AddTags(const std::vector<Entity*>& entities)
+{
+    ComponentRegistry::Register<TagType>();
+    auto& storage = GetRegistry().storage<TagType>();
+
+    std::vector<entt::entity> handles;
+    handles.reserve(entities.size());
+    for (Entity* const entity : entities)
+    {
+        assert(entity && entity->_scene == this && "Bulk operations only take entities of this scene");
+        if (!storage.contains(entity->_handle)) handles.push_back(entity->_handle);
+    }
+    storage.insert(handles.begin(), handles.end());
+    return handles.size();
+}
+
+template<typename TagType, typename... QueryTypes>
+size_t Scene::AddTagsWhere()
+{
+    static_assert(std::is_base_of_v<Tag, TagType>, "TagType must inherit from Tag");
+    static_assert(sizeof...(QueryTypes) > 0, "AddTagsWhere needs at least one query type");
+
+    ComponentRegistry::Register<TagType>();
+    auto& storage = GetRegistry().storage<TagType>();
+
+    std::vector<entt::entity> handles;
+    for (const entt::entity handle : GetRegistry().view<QueryTypes...>())
+    {
+        if (!storage.contains(handle)) handles.push_back(handle);
+    }
+    storage.insert(handles.begin(), handles.end());
+    return handles.size();
+}
+
+template<typename ComponentType>
+size_t Scene::InsertComponents(entt::storage_for_t<ComponentType>& storage,
+    const std::vector<Entity*>& owners, const ComponentType& value)
+{
+    std::vector<entt::entity> handles;
+    handles.reserve(owners.size());
+    for (Entity* const owner : owners) handles.push_back(owner->_handle);
+
+    storage.insert(handles.begin(), handles.end(), value);
+    for (Entity* const owner : owners) storage.get(owner->_handle)._owner = owner;
+    return handles.size();
+}
+
+
+
+// ========== Reserved Entities ==========
+
+
+
+template<typename ComponentType>
+void Scene::CommitStaged(const std::vector<Entity*>& owners, std::vector<ComponentType>& values)
+{
+    assert(owners.size() == values.size() && "Staged owners and values must stay parallel");
+
+    ComponentRegistry::Register<ComponentType>();
+    auto& storage = GetRegistry().storage<ComponentType>();
+    storage.reserve(storage.size() + values.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        Entity* const owner = owners[i];
+        if (!owner->IsValid()) continue;
+
+        // Staging a type twice for one entity keeps the last value
+        ComponentType& comp = storage.contains(owner->_handle)
+            ? (storage.get(owner->_handle) = std::move(values[i]))
+            : storage.emplace(owner->_handle, std::move(values[i]));
+        comp._owner = owner;
+    }
+}
+
+template<typename TagType>
+void Scene::CommitStagedTags(const std::vector<Entity*>& owners)
+{
+    ComponentRegistry::Register<TagType>();
+    auto& storage = GetRegistry().storage<TagType>();
+    storage.reserve(storage.size() + owners.size());
+
+    for (Entity* const owner : owners)
+    {
+        if (owner->IsValid() && !storage.contains(owner->_handle)) storage.emplace(owner->_handle);
+    }
+}
+
+
+
+// ========== Pool Warm-Up ==========
+
+
+
+template<typename ComponentType, typename>
+void Scene::DeclareComponent(const size_t capacity)
+{
+    // Register up front as well, data loaded from disk may reference the type before it is created
+    ComponentRegistry::Register<ComponentType>();
+
+    const entt::id_type id = entt::type_hash<ComponentType>::value();
+    auto it = std::find_if(_declaredPools.begin(), _declaredPools.end(),
+        [id](const PoolDeclaration& declaration) { return declaration.id == id; });
+
+    if (it == _declaredPools.end())
+    {
+        _declaredPools.push_back(PoolDeclaration{id, capacity, &WarmPool<ComponentType>});
+    }
+    else
+    {
+        it->capacity = std::max(it->capacity, capacity);
+    }
+
+    if (_registry.has_value()) WarmPool<ComponentType>(*_registry, capacity);
+}
+
+template<typename ComponentType, typename>
+size_t Scene::GetPoolCapacity() const
+{
+    const auto* const storage = GetRegistry().template storage<ComponentType>();
+    return storage ? storage->capacity() : 0;
+}
+
+template<typename ComponentType>
+void Scene::WarmPool(entt::registry& registry, const size_t capacity)
+{
+    auto& storage = registry.storage<ComponentType>();
+    if (capacity > storage.capacity()) storage.reserve(capacity);
+}
+
+
+
+// ========== Rotation Maintenance ==========
+
+
+
+template<typename... QueryTypes>
+size_t Scene::NormalizeRotations(const float tolerance)
+{
+    auto view = GetRegistry().view<Transform, QueryTypes...>();
+
+    RotationBatch batch;
+    for (const entt::entity handle : view) batch.Add(&view.template get<Transform>(handle));
+    batch.Normalize(tolerance);
+    return batch.Apply();
+}
+
+template<typename Source, typename... QueryTypes>
+size_t Scene::IntegrateRotations(const float deltaTime, math::Vec3 Source::* const angularVelocity)
+{
+    static_assert(std::is_base_of_v<Component, Source>, "Source must inherit from Component");
+
+    auto view = GetRegistry().view<Transform, Source, QueryTypes...>();
+
+    RotationBatch batch;
+    for (const entt::entity handle : view)
+    {
+        batch.Add(&view.template get<Transform>(handle), view.template get<Source>(handle).*angularVelocity);
+    }
+    batch.Integrate(deltaTime);
+    return batch.Apply();
+}
+
+template<typename Source, typename... QueryTypes>
+size_t Scene::SlerpRotations(const float t, math::Quat Source::* const target)
+{
+    static_assert(std::is_base_of_v<Component, Source>, "Source must inherit from Component");
+
+    auto view = GetRegistry().view<Transform, Source, QueryTypes...>();
+
+    RotationBatch batch;
+    for (const entt::entity handle : view)
+    {
+        batch.Add(&view.template get<Transform>(handle), view.template get<Source>(handle).*target);
+    }
+    batch.Slerp(t);
+    return batch.Apply();
+}
+
+
+
+// ========== Relations ==========
+
+
+
+template<typename Kind>
+bool Scene::TryAddRelation(const Entity* const source, const Entity* const target)
+{
+    if (!IsEntityHandleValid(source) || !IsEntityHandleValid(target)) return false;
+    return GetRelationIndex<Kind>().TryAdd(source->_handle, target->_handle);
+}
+
+template<typename Kind>
+bool Scene::TryRemoveRelation(const Entity* const source, const Entity* const target)
+{
+    auto it = _relations.find(std::type_index(typeid(Kind)));
+    if (it == _relations.end() || !source || !target) return false;
+    return it->second.TryRemove(source->_handle, target->_handle);
+}
+
+template<typename Kind>
+bool Scene::HasRelation(const Entity* const source, const Entity* const target) const
+{
+    const RelationIndex* const index = TryGetRelationIndex<Kind>();
+    return index && source && target && index->Contains(source->_handle, target->_handle);
+}
+
+template<typename Kind>
+size_t Scene::GetRelationTargetCount(const Entity* const source) const
+{
+    const RelationIndex* const index = TryGetRelationIndex<Kind>();
+    return (index && source) ? index->GetTargets(source->_handle).size() : 0;
+}
+
+template<typename Kind>
+size_t Scene::GetRelationSourceCount(const Entity* const target) const
+{
+    const RelationIndex* const index = TryGetRelationIndex<Kind>();
+    return (index && target) ? index->GetSources(target->_handle).size() : 0;
+}
+
+template<typename Kind, typename Func>
+void Scene::ForEachRelationTarget(const Entity* const source, Func&& callback)
+{
+    const RelationIndex* const index = TryGetRelationIndex<Kind>();
+    if (!index || !source) return;
+
+    for (const entt::entity handle : index->GetTargets(source->_handle))
+    {
+        Entity* const entity = TryGetEntity(handle);
+        assert(entity && "Relations of destroyed entities should have been released");
+        callback(entity);
+    }
+}
+
+template<typename Kind, typename Func>
+void Scene::ForEachRelationSource(const Entity* const target, Func&& callback)
+{
+    const RelationIndex* const index = TryGetRelationIndex<Kind>();
+    if (!index || !target) return;
+
+    for (const entt::entity handle : index->GetSources(target->_handle))
+    {
+        Entity* const entity = TryGetEntity(handle);
+        assert(entity && "Relations of destroyed entities should have been released");
+        callback(entity);
+    }
+}
+
+template<typename Kind>
+size_t Scene::ClearRelations(const Entity* const entity)
+{
+    auto it = _relations.find(std::type_index(typeid(Kind)));
+    if (it == _relations.end() || !entity) return 0;
+    return it->second.Release(entity->_handle);
+}
+
+
+
+// ========== Cached Queries ==========
+
+
+
+template<typename Signature, typename Excluded>
+CachedQuery<Signature, Excluded>* Scene::CreateCachedQuery(std::function<bool(Entity*)> filter)
+{
+    auto query = std::make_unique<CachedQuery<Signature, Excluded>>(this, std::move(filter));
+    CachedQuery<Signature, Excluded>* const result = query.get();
+    _cachedQueries.push_back(std::move(query));
+    return result;
+}
+
+
+
+// ========== Events ==========
+
+
+
+template<typename EventType>
+EventChannel<EventType>& Scene::GetEventChannel()
+{
+    auto it = _eventChannels.find(std::type_index(typeid(EventType)));
+    if (it == _eventChannels.end())
+    {
+        EventChannelSlot slot;
+        slot.channel = std::unique_ptr<void, void (*)(void*)>(
+            new EventChannel<EventType>(*GetWorld()->workers),
+            [](void* channel) { delete static_cast<EventChannel<EventType>*>(channel); });
+        slot.swap = [](void* channel) { static_cast<EventChannel<EventType>*>(channel)->Swap(); };
+        it = _eventChannels.emplace(std::type_index(typeid(EventType)), std::move(slot)).first;
+    }
+    return *static_cast<EventChannel<EventType>*>(it->second.channel.get());
+}
+
+
+
 // ========== System Management ==========
 
 
@@ -207,12 +645,8 @@ template<typename... TagsOrComponents, typename Func>
 void Scene::Query(Func&& callback)
 {
     static_assert(sizeof...(TagsOrComponents) > 1, "Use single component Query overload for single component queries");
-    
-    GetRegistry().view<TagsOrComponents...>().each([this, callback = std::forward<Func>(callback)](entt::entity e, TagsOrComponents&... tagsOrComps) {
-        Entity* entity = TryGetEntity(e);
-        assert(entity && "Should always be able to lookup entity via entt handle");
-        callback(entity, tagsOrComps...);
-    });
+
+    PrefetchedQuery<TagsOrComponents...>(callback);
 }
 
 template<typename TagOrComponent>
@@ -233,12 +667,82 @@ template<typename... TagsOrComponents>
 void Scene::Query(std::function<void(Entity*, TagsOrComponents&...)> callback)
 {
     static_assert(sizeof...(TagsOrComponents) > 1, "Use single component Query overload for single component queries");
-    
-    GetRegistry().view<TagsOrComponents...>().each([this, &callback](entt::entity e, TagsOrComponents&... tagsOrComps) {
+
+    PrefetchedQuery<TagsOrComponents...>(callback);
+}
+
+template<typename... TagsOrComponents, typename Func>
+void Scene::PrefetchedQuery(Func& callback)
+{
+    using First = std::tuple_element_t<0, std::tuple<TagsOrComponents...>>;
+
+    auto view = GetRegistry().view<TagsOrComponents...>();
+
+    // Only addresses are taken ahead, so a callback changing the pools never leaves stale references
+    const auto prefetch = [&view](const entt::entity e) {
+        if (!view.contains(e)) return;
+        (VELECS_ECS_PREFETCH(&view.template get<TagsOrComponents>(e)), ...);
+    };
+
+    auto ahead = view.begin();
+    const auto end = view.end();
+    for (size_t i = 0; i < QUERY_PREFETCH_DISTANCE && ahead != end; ++i) prefetch(*ahead++);
+
+    for (const entt::entity e : view)
+    {
+        if (ahead != end) prefetch(*ahead++);
+
+        // Components know their owner, which spares the two hash lookups of TryGetEntity()
+        Entity* entity{nullptr};
+        if constexpr (std::is_base_of_v<Component, First>) entity = view.template get<First>(e)._owner;
+        else entity = TryGetEntity(e);
+        assert(entity && "Should always be able to lookup entity via entt handle");
+
+        callback(entity, view.template get<TagsOrComponents>(e)...);
+    }
+}
+
+
+
+// ========== Parallel Execution ==========
+
+
+
+template<typename... ComponentTypes, typename Func>
+void Scene::ParallelQuery(Func&& callback)
+{
+    static_assert(sizeof...(ComponentTypes) > 0, "ParallelQuery needs at least one component type");
+
+    // Resolve everything on the frame thread, workers only touch the rows they are handed
+    using Row = std::tuple<Entity*, ComponentTypes*...>;
+    std::vector<Row> rows;
+    GetRegistry().view<ComponentTypes...>().each([this, &rows](entt::entity e, ComponentTypes&... comps) {
         Entity* entity = TryGetEntity(e);
         assert(entity && "Should always be able to lookup entity via entt handle");
-        callback(entity, tagsOrComps...);
+        rows.emplace_back(entity, &comps...);
+    });
+    if (rows.empty()) return;
+
+    WorkerPool& workers = *GetWorld()->workers;
+    const size_t chunkSize = GetChunkSize(rows.size(), workers.GetThreadCount());
+    const size_t chunkCount = (rows.size() + chunkSize - 1) / chunkSize;
+
+    std::vector<CommandBuffer> buffers(chunkCount);
+    workers.ParallelFor(chunkCount, [&rows, &buffers, &callback, chunkSize](const size_t chunk) {
+        CommandBuffer& buffer = buffers[chunk];
+        buffer._chunkIndex = chunk;
+
+        const size_t end = std::min(rows.size(), (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; ++i)
+        {
+            std::apply([&buffer, &callback](Entity* entity, ComponentTypes*... comps) {
+                callback(buffer, entity, *comps...);
+            }, rows[i]);
+        }
     });
+
+    // Merge in chunk order so handle allocation matches a serial run
+    for (CommandBuffer& buffer : buffers) ApplyCommands(buffer);
 }
 
 // Protected Methods
@@ -262,8 +766,22 @@ bool Scene::TryAddSystem(std::unique_ptr<SystemType> system)
         });
     _systemsIterator.insert(insertPos, id);
 
+    it->second->_scene = this;
     it->second->Init();
     return inserted;
 }
 
+template<typename Kind>
+RelationIndex& Scene::GetRelationIndex()
+{
+    return _relations[std::type_index(typeid(Kind))];
+}
+
+template<typename Kind>
+const RelationIndex* Scene::TryGetRelationIndex() const
+{
+    auto it = _relations.find(std::type_index(typeid(Kind)));
+    return it != _relations.end() ? &it->second : nullptr;
+}
+
 } // namespace velecs::ecs
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <velecs/common/Uuid.hpp>
+using velecs::common::Uuid;
+
+#include <functional>
+
+namespace velecs::ecs {
+
+class Entity;
+
+/// @struct SceneCommand
+/// @brief A deferred structural change applied to a scene on the frame thread.
+/// @details Commands reference entities by UUID rather than pointer so producers on other
+///          threads never hold pointers into the ECS. The target is resolved when the
+///          command executes; commands whose target no longer exists are dropped.
+struct SceneCommand {
+    /// @enum Type
+    /// @brief Kind of structural change.
+    enum class Type {
+        Spawn,   ///< @brief Create an entity, then run the callback on it.
+        Destroy, ///< @brief Mark the target entity (and its children) for destruction.
+        Update,  ///< @brief Run the callback on the target entity, e.g. to add or edit components.
+    };
+
+    Type type{Type::Update};                     ///< @brief Kind of structural change.
+    Uuid target{Uuid::INVALID};                  ///< @brief Target entity for Destroy and Update commands.
+    std::function<void(Entity* const)> callback; ///< @brief Optional work run on the spawned or target entity.
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+namespace velecs::ecs {
+
+/// @struct CompactionPolicy
+/// @brief Occupancy thresholds that make a scene compact itself after entity cleanup.
+/// @details Checked at the end of every cleanup phase that destroyed entities. A pool counts as
+///          underused when it holds fewer than minOccupancy of its capacity; tombstones left by
+///          in-place deletion count as occupied, since compaction is what removes them. Capacity
+///          reserved through Scene::DeclareComponent() also counts as occupied.
+struct CompactionPolicy {
+    bool enabled{false};       ///< @brief Whether cleanup compacts automatically.
+    float minOccupancy{0.25f}; ///< @brief Fraction of capacity in use below which a container is compacted.
+    size_t minCapacity{4096};  ///< @brief Containers smaller than this are never worth compacting.
+};
+
+/// @struct CompactionReport
+/// @brief What a call to Scene::Compact() released.
+struct CompactionReport {
+    size_t poolsCompacted{0};    ///< @brief Pools that dropped tombstones or capacity.
+    size_t tombstonesRemoved{0}; ///< @brief Holes left by in-place deletion that were filled.
+    size_t entitiesReleased{0};  ///< @brief Destroyed entities whose Entity objects were released.
+    size_t bytesReclaimed{0};    ///< @brief Estimated number of bytes given back to the allocator.
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "velecs/ecs/BinaryStream.hpp"
+#include "velecs/ecs/ComponentRegistry.hpp"
+#include "velecs/ecs/EntityBuilder.hpp"
+#include "velecs/ecs/TypeConstraints.hpp"
+
+#include <velecs/common/Uuid.hpp>
+using velecs::common::Uuid;
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Scene;
+
+/// @class SceneJournal
+/// @brief Undo/redo history of fine-grained scene edits, for editors that drive a live scene.
+///
+/// Edits made through the journal are applied to the scene immediately and recorded as compact
+/// binary operations holding just enough to invert them, so undo and redo cost time proportional
+/// to the edit rather than to the scene:
+///  - Component writes store the codec bytes before and after the edit.
+///  - Reparenting and sibling moves store the old and new parent and index.
+///  - Creation and destruction hibernate the subtree instead of destroying it, so Entity pointers
+///    and UUIDs stay valid across undo and redo.
+///
+/// Consecutive edits of the same kind to the same target coalesce into one operation that keeps
+/// the oldest "before" state, so dragging a gizmo or a slider records a single step. Call
+/// BreakCoalescing() when the gesture ends. Edits between BeginTransaction() and EndTransaction()
+/// form one step.
+///
+/// The journal must be the only thing editing the entities it has recorded. Operations refer to
+/// entities by UUID, so an entity destroyed behind the journal's back makes the steps touching it
+/// fail with a warning instead of dangling. Entities destroyed through the journal stay
+/// hibernated once their step is trimmed from the history or discarded by a new edit after an
+/// undo. Relations are not journaled: destroying an entity drops its relations, and undoing the
+/// destruction does not restore them.
+///
+/// @code
+/// SceneJournal journal(scene);
+/// journal.TryEdit<Transform>(selected, [&](Transform& transform) { transform.SetPos(dragPos); });
+/// journal.BreakCoalescing();
+/// journal.TryUndo();
+/// @endcode
+class SceneJournal {
+public:
+    // Public Fields
+
+    /// @brief Default number of undo steps kept before the oldest is dropped.
+    static const size_t DEFAULT_MAX_STEPS = 256;
+
+    // Constructors and Destructors
+
+    /// @brief Creates an empty journal for a scene.
+    /// @param scene The edited scene. Must outlive the journal.
+    /// @param maxSteps Number of undo steps kept. Must be positive.
+    explicit SceneJournal(Scene* const scene, const size_t maxSteps = DEFAULT_MAX_STEPS);
+
+    /// @brief Deleted default constructor.
+    SceneJournal() = delete;
+
+    /// @brief Default destructor.
+    ~SceneJournal() = default;
+
+    // Public Methods
+
+    /// @brief Creates an entity and records its creation.
+    /// @return Builder for the new entity. Changes made through it are part of the creation.
+    EntityBuilder CreateEntity();
+
+    /// @brief Destroys an entity and its subtree, recording the destruction.
+    /// @param root The subtree root to destroy.
+    /// @return True if the subtree was destroyed.
+    /// @details Relations of the subtree are dropped and are not restored by undo.
+    bool TryDestroy(Entity* const root);
+
+    /// @brief Edits a component and records the change.
+    /// @tparam ComponentType The component type. Must have a codec.
+    /// @param entity The entity owning the component.
+    /// @param edit Called once with the component to modify.
+    /// @return True if the entity is valid and has the component.
+    template<typename ComponentType, typename Func, typename = IsComponent<ComponentType>>
+    bool TryEdit(Entity* const entity, Func&& edit);
+
+    /// @brief Reparents an entity and records the change.
+    /// @param entity The entity to move.
+    /// @param newParent The new parent, or nullptr to make the entity a root.
+    /// @return True if the parent was changed.
+    bool TrySetParent(Entity* const entity, Entity* const newParent);
+
+    /// @brief Moves an entity among its siblings and records the change.
+    /// @param entity The entity to move. Must have a parent.
+    /// @param index The new sibling index, clamped to the valid range.
+    /// @return True if the index was changed.
+    bool TrySetSiblingIndex(Entity* const entity, const size_t index);
+
+    /// @brief Starts grouping edits into a single step. Calls may nest.
+    void BeginTransaction();
+
+    /// @brief Ends the innermost transaction. The outermost one closes the step.
+    void EndTransaction();
+
+    /// @brief Stops the next edit from coalescing with the previous one.
+    inline void BreakCoalescing() { _canCoalesce = false; }
+
+    /// @brief Reverts the most recent step.
+    /// @return True if a step was undone.
+    bool TryUndo();
+
+    /// @brief Reapplies the most recently undone step.
+    /// @return True if a step was redone.
+    bool TryRedo();
+
+    /// @brief Gets the number of steps that can be undone.
+    inline size_t GetUndoCount() const { return _cursor; }
+
+    /// @brief Gets the number of steps that can be redone.
+    inline size_t GetRedoCount() const { return _steps.size() - _cursor; }
+
+    /// @brief Gets the total size of the encoded history in bytes, including the entity table.
+    size_t GetByteSize() const;
+
+    /// @brief Forgets the whole history.
+    void Clear();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @brief Entity index stored for a missing parent.
+    static const uint32_t NO_ENTITY = UINT32_MAX;
+
+    /// @enum OpCode
+    /// @brief Kind of a recorded operation, the first byte of its encoding.
+    enum class OpCode : uint8_t {
+        Create,   ///< @brief [entity]
+        Destroy,  ///< @brief [entity]
+        Write,    ///< @brief [entity][component id][before size][before][after size][after]
+        Reparent, ///< @brief [entity][old parent][old index][new parent][new index]
+    };
+
+    /// @struct Step
+    /// @brief One undoable unit holding one or more encoded operations.
+    struct Step {
+        std::vector<unsigned char> data; ///< @brief Operations, back to back.
+        std::vector<uint32_t> ops;       ///< @brief Offset of each operation in data.
+    };
+
+    Scene* const _scene;     ///< @brief The edited scene.
+    const size_t _maxSteps;  ///< @brief Number of undo steps kept.
+
+    std::vector<Step> _steps; ///< @brief Recorded steps, oldest first.
+    size_t _cursor{0};        ///< @brief Steps before the cursor can be undone, the rest redone.
+
+    /// @brief Minimum table size before trimmed steps trigger a compaction of the entity table.
+    static const size_t MIN_TABLE_COMPACTION = 64;
+
+    std::vector<Uuid> _entityTable;                     ///< @brief Entities referenced by operations.
+    std::unordered_map<Uuid, uint32_t> _entityIndices;  ///< @brief Index of each entity in the table.
+    size_t _tableCompactionSize{MIN_TABLE_COMPACTION};  ///< @brief Table size at which the next compaction runs.
+
+    size_t _transactionDepth{0};     ///< @brief Number of open transactions.
+    bool _transactionHasStep{false}; ///< @brief Whether the open transaction has started its step.
+    bool _canCoalesce{false};        ///< @brief Whether the next edit may merge into the last operation.
+
+    // Private Methods
+
+    /// @brief Gets the table index of an entity, adding it if needed.
+    uint32_t GetEntityIndex(Entity* const entity);
+
+    /// @brief Finds the entity behind a table index.
+    /// @return The entity, or nullptr if it no longer exists.
+    Entity* TryResolve(const uint32_t entityIndex) const;
+
+    /// @brief Drops the table entries no remaining step refers to, once the table has grown enough.
+    /// @details Called after steps are trimmed, so the table stays proportional to the history
+    ///          instead of to every entity ever edited. Renumbers the indices stored in the steps.
+    void TrimEntityTable();
+
+    /// @brief Gets the step new operations are appended to, starting one if needed.
+    /// @details Discards every redoable step.
+    Step& GetRecordingStep();
+
+    /// @brief Gets the last operation of the last step if the next edit may merge into it.
+    /// @param op Required kind of the operation.
+    /// @param entityIndex Required entity of the operation.
+    /// @param outOffset Set to the operation's offset.
+    /// @return The step holding the operation, or nullptr if the edit cannot coalesce.
+    Step* TryGetCoalescable(const OpCode op, const uint32_t entityIndex, size_t& outOffset);
+
+    /// @brief Records a component write, merging it into the last write of the same component.
+    void RecordWrite(Entity* const entity, const entt::id_type id,
+        const std::vector<unsigned char>& before, const std::vector<unsigned char>& after);
+
+    /// @brief Records a hierarchy change, merging it into the last change of the same entity.
+    void RecordReparent(Entity* const entity, Entity* const oldParent, const size_t oldIndex,
+        Entity* const newParent, const size_t newIndex);
+
+    /// @brief Records creation or destruction of an entity.
+    void RecordLifetime(const OpCode op, Entity* const entity);
+
+    /// @brief Applies or reverts a single encoded operation.
+    /// @param step The step holding the operation.
+    /// @param offset Offset of the operation in the step.
+    /// @param undo True to revert, false to reapply.
+    /// @return True if the operation applied cleanly.
+    bool TryApply(const Step& step, const size_t offset, const bool undo);
+
+    /// @brief Moves an entity to a parent and sibling index without recording.
+    bool TryPlace(Entity* const entity, Entity* const parent, const size_t index);
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/SceneJournal.inl"
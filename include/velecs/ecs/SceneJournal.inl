@@ -0,0 +1,32 @@
+#include "velecs/ecs/Entity.hpp"
+
+namespace velecs::ecs {
+
+// Public Methods
+
+template<typename ComponentType, typename Func, typename>
+bool SceneJournal::TryEdit(Entity* const entity, Func&& edit)
+{
+    static_assert(HasCodec<ComponentType>::value, "Journaled components must provide Serialize and Deserialize");
+
+    ComponentType* comp{nullptr};
+    if (!entity || !entity->IsValid() || !entity->template TryGetComponent<ComponentType>(comp)) return false;
+
+    // Undo resolves the codec by type id, so make sure it can be found
+    ComponentRegistry::Register<ComponentType>();
+
+    std::vector<unsigned char> before;
+    BinaryWriter beforeWriter(before);
+    comp->Serialize(beforeWriter);
+
+    edit(*comp);
+
+    std::vector<unsigned char> after;
+    BinaryWriter afterWriter(after);
+    comp->Serialize(afterWriter);
+
+    RecordWrite(entity, entt::type_hash<ComponentType>::value(), before, after);
+    return true;
+}
+
+} // namespace velecs::ecs
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "velecs/ecs/Object.hpp"
+#include "velecs/ecs/SceneReleaser.hpp"
 #include "velecs/ecs/TypeConstraints.hpp"
 
 #include <velecs/common/NameUuidRegistry.hpp>
@@ -9,6 +10,7 @@ using velecs::common::NameUuidRegistry;
 using velecs::common::Uuid;
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -16,6 +18,7 @@ namespace velecs::ecs {
 
 class World;
 class Scene;
+class MetricsExporter;
 
 /// @class SceneManager
 /// @brief Manages scene lifecycle and handles transitions between different game scenes.
@@ -53,7 +56,7 @@ public:
     // Constructors and Destructors
 
     inline SceneManager(World* const world)
-        : _world(world) {}
+        : _world(world), _releaser(std::make_unique<SceneReleaser>()) {}
 
     /// @brief Default constructor.
     SceneManager() = delete;
@@ -134,6 +137,39 @@ public:
     /// @brief Checks if the scene registry is empty.
     /// @return true if no scenes are registered, false otherwise.
     bool IsEmpty() const;
+
+    /// @brief Attaches a metrics exporter fed at the end of each frame.
+    /// @param exporter The exporter to feed, or nullptr to detach the current one.
+    /// @details The SceneManager does not own the exporter; it must outlive the attachment.
+    ///          A snapshot is only collected when the exporter reports one is due, and handing
+    ///          it over never blocks the frame.
+    inline void SetMetricsExporter(MetricsExporter* const exporter) { _metricsExporter = exporter; }
+
+    /// @brief Gets the number of scene transitions processed so far.
+    /// @return Number of completed transitions, including reloads.
+    inline uint64_t GetTransitionCount() const { return _transitionCount; }
+
+    /// @brief Gets how long the last scene transition took.
+    /// @return Duration of the last OnExit/OnEnter pair, or zero if none happened yet.
+    inline std::chrono::nanoseconds GetLastTransitionDuration() const { return _lastTransitionDuration; }
+
+    /// @brief Sets whether outgoing scenes are destroyed on a background thread.
+    /// @param enabled True to hand outgoing scenes to the releaser thread, false to destroy them
+    ///                during the transition. Enabled by default.
+    /// @details Component destructors then run on the releaser thread, unless the type opts out
+    ///          through ComponentTraits::mainThreadDestruction.
+    inline void SetBackgroundRelease(const bool enabled) { _backgroundRelease = enabled; }
+
+    /// @brief Checks whether outgoing scenes are destroyed on a background thread.
+    inline bool IsBackgroundReleaseEnabled() const { return _backgroundRelease; }
+
+    /// @brief Gets the number of outgoing scenes still being destroyed in the background.
+    inline size_t GetPendingReleaseCount() const { return _releaser->GetPendingCount(); }
+
+    /// @brief Blocks until every outgoing scene has been destroyed.
+    /// @details Useful before measuring memory or shutting down subsystems that released
+    ///          components may still reference.
+    inline void FlushReleases() { _releaser->Flush(); }
     
 
     /// #############################################################
@@ -155,6 +191,8 @@ public:
     /// @brief Processes all enabled systems in the main logic phase for the current scene.
     /// @param context Execution context data passed to each system.
     /// @return true if processing succeeded, false if no active scene.
+    /// @details Swaps the scene's event channels, then drains its cross-thread command queue,
+    ///          before any system runs.
     bool Internal_TryProcess(void* context);
 
     /// @brief Processes all enabled systems in the physics phase for the current scene.
@@ -169,6 +207,7 @@ public:
 
     /// @brief Processes cleanup and entity destruction for the current scene.
     /// @return true if processing succeeded, false if no active scene.
+    /// @details Also hands a metrics snapshot to the attached exporter when one is due.
     bool Internal_TryProcessEntityCleanup();
 
 protected:
@@ -183,7 +222,17 @@ private:
     Scene* _currentScene{nullptr};
     Scene* _targetScene{nullptr};
 
+    MetricsExporter* _metricsExporter{nullptr};           ///< @brief Optional exporter fed at the end of each frame.
+    uint64_t _transitionCount{0};                         ///< @brief Number of processed scene transitions.
+    std::chrono::nanoseconds _lastTransitionDuration{0};  ///< @brief Duration of the last scene transition.
+
+    std::unique_ptr<SceneReleaser> _releaser;             ///< @brief Thread destroying outgoing scenes.
+    bool _backgroundRelease{true};                        ///< @brief Whether outgoing scenes go to the releaser.
+
     // Private Methods
+
+    /// @brief Collects a metrics snapshot and hands it to the exporter if one is due.
+    void TrySubmitMetrics();
 };
 
 } // namespace velecs::ecs
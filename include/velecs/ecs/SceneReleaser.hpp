@@ -0,0 +1,87 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Object;
+
+/// @struct DetachedScene
+/// @brief State of a scene that was cleaned up and no longer belongs to any scene or the World.
+/// @details Nothing in the ECS points into it anymore, so it can be destroyed on any thread.
+struct DetachedScene {
+    std::optional<entt::registry> registry;         ///< @brief The scene's registry, with every pool still allocated.
+    std::vector<std::unique_ptr<Object>> entities;  ///< @brief Entity objects removed from the World.
+};
+
+/// @class SceneReleaser
+/// @brief Destroys detached scenes on a background thread.
+///
+/// Releasing a large scene means running every component destructor and freeing every pool page
+/// and Entity object, which can take several frames worth of time. The SceneManager detaches the
+/// outgoing scene during a transition and submits it here, so the next scene starts immediately.
+///
+/// Components whose destructors must run on the frame thread opt out through
+/// ComponentTraits::mainThreadDestruction; their pools are destroyed before the scene is detached.
+class SceneReleaser {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Starts the releaser thread.
+    SceneReleaser();
+
+    /// @brief Releases every submitted scene, then stops the releaser thread.
+    ~SceneReleaser();
+
+    // Delete copy and move operations since the releaser owns a running thread
+    SceneReleaser(const SceneReleaser&) = delete;
+    SceneReleaser& operator=(const SceneReleaser&) = delete;
+    SceneReleaser(SceneReleaser&&) = delete;
+    SceneReleaser& operator=(SceneReleaser&&) = delete;
+
+    // Public Methods
+
+    /// @brief Hands a detached scene to the releaser thread without blocking.
+    /// @param scene The scene state to destroy.
+    void Submit(DetachedScene&& scene);
+
+    /// @brief Blocks until every submitted scene has been released.
+    void Flush();
+
+    /// @brief Gets the number of submitted scenes not fully released yet.
+    size_t GetPendingCount() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    mutable std::mutex _mutex;          ///< @brief Guards _pending, _releasing and _stopping.
+    std::condition_variable _wakeup;    ///< @brief Signals a submitted scene or shutdown.
+    std::condition_variable _idle;      ///< @brief Signals that every submitted scene was released.
+    std::deque<DetachedScene> _pending; ///< @brief Scenes waiting to be released, oldest first.
+    bool _releasing{false};             ///< @brief Whether the thread is releasing a scene right now.
+    bool _stopping{false};              ///< @brief Set when the releaser is shutting down.
+
+    std::thread _thread;                ///< @brief Thread destroying detached scenes.
+
+    // Private Methods
+
+    /// @brief Releaser thread loop.
+    void Run();
+};
+
+} // namespace velecs::ecs
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Enables the per-scene hot-path counters.
+/// @details Defined by the build (see VELECS_ECS_ENABLE_STATS in CMakeLists.txt). When set to 0
+///          every VELECS_ECS_COUNT call compiles to nothing.
+#ifndef VELECS_ECS_STATS_ENABLED
+#define VELECS_ECS_STATS_ENABLED 1
+#endif
+
+#if VELECS_ECS_STATS_ENABLED
+/// @brief Increments a hot-path counter on the given scene.
+#define VELECS_ECS_COUNT(scene, counter) \
+    (scene)->IncrementCounter(::velecs::ecs::SceneCounter::counter)
+/// @brief Adds an arbitrary amount to a hot-path counter on the given scene.
+#define VELECS_ECS_COUNT_N(scene, counter, amount) \
+    (scene)->IncrementCounter(::velecs::ecs::SceneCounter::counter, (amount))
+#else
+#define VELECS_ECS_COUNT(scene, counter) ((void)0)
+#define VELECS_ECS_COUNT_N(scene, counter, amount) ((void)0)
+#endif
+
+namespace velecs::ecs {
+
+/// @enum SceneCounter
+/// @brief Identifies an expensive internal operation tracked per scene.
+enum class SceneCounter : size_t {
+    EntityLookups,   ///< @brief Handle to Entity resolutions through Scene::TryGetEntity.
+    WorldLookups,    ///< @brief Map lookups performed against the World object storage.
+    ValidityChecks,  ///< @brief Entity validity checks (Entity::IsValid / Scene::IsEntityHandleValid).
+    ModelRecomputes, ///< @brief Local-to-parent matrix recomputes (Transform::CalculateModel).
+    WorldRecomputes, ///< @brief Local-to-world matrix recomputes (Transform::CalculateWorld).
+    DirtyVisits,     ///< @brief Nodes visited while propagating world dirtiness (Transform::SetWorldDirty).
+    Count,           ///< @brief Number of counters, not a counter itself.
+};
+
+/// @struct SceneStats
+/// @brief Snapshot of a scene's hot-path counters.
+/// @details Values are either the running totals of the frame in progress or the totals of the
+///          last completed frame, depending on which Scene accessor produced the snapshot.
+struct SceneStats {
+    uint64_t entityLookups{0};   ///< @brief See SceneCounter::EntityLookups.
+    uint64_t worldLookups{0};    ///< @brief See SceneCounter::WorldLookups.
+    uint64_t validityChecks{0};  ///< @brief See SceneCounter::ValidityChecks.
+    uint64_t modelRecomputes{0}; ///< @brief See SceneCounter::ModelRecomputes.
+    uint64_t worldRecomputes{0}; ///< @brief See SceneCounter::WorldRecomputes.
+    uint64_t dirtyVisits{0};     ///< @brief See SceneCounter::DirtyVisits.
+};
+
+} // namespace velecs::ecs
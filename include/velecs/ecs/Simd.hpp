@@ -0,0 +1,11 @@
+#pragma once
+
+/// @brief Enables the hand-written SSE kernels.
+/// @details Set on every x86-64 target and on 32-bit x86 builds with SSE2 enabled. Other
+///          targets use the scalar fallback of each kernel, which computes the same results.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VELECS_ECS_SSE 1
+#else
+#define VELECS_ECS_SSE 0
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "velecs/ecs/TypeConstraints.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Scene;
+
+/// @class SortedQuery
+/// @brief Keeps the entities owning a key component sorted across frames.
+/// @tparam KeyComponent The component the order is based on.
+/// @tparam Compare Strict weak ordering called as compare(const KeyComponent&, const KeyComponent&).
+///
+/// Re-sorting a query every frame costs O(n log n) even when almost nothing moved. A sorted query
+/// remembers the order and listens to the key pool's construct, update and destroy signals, so
+/// the next Each() only repairs what changed:
+///  - A few changed or added keys are pulled out, sorted on their own and merged back in, in
+///    O(n + k log k).
+///  - When many keys changed, every key usually drifted a little (distances, depths), so the
+///    whole order is insertion sorted, which is linear on nearly sorted data. If that turns out
+///    to do too many moves, it falls back to a full sort.
+///
+/// EnTT only signals updates made through registry patch() or replace(). Keys modified through
+/// a plain reference must be reported with MarkDirty().
+///
+/// The query connects to the scene's registry when constructed, so create it after the scene is
+/// initialized and destroy it before the scene is cleaned up, e.g. in OnEnter() and OnExit().
+///
+/// @code
+/// struct ByDepth { bool operator()(const Depth& a, const Depth& b) const { return a.z < b.z; } };
+/// SortedQuery<Depth, ByDepth> drawOrder(scene);
+/// drawOrder.Each([](Entity* entity, Depth& depth) { Draw(entity); });
+/// @endcode
+template<typename KeyComponent, typename Compare>
+class SortedQuery {
+public:
+    // Public Fields
+
+    /// @brief Changed keys are merged in while they are at most this fraction (1/n) of the order.
+    static const size_t MERGE_DIVISOR = 8;
+
+    /// @brief Average element moves per entry an insertion sort may spend before a full sort.
+    static const size_t INSERTION_BUDGET = 8;
+
+    // Constructors and Destructors
+
+    /// @brief Sorts every entity currently owning the key and starts listening for changes.
+    /// @param scene The queried scene. Must be initialized.
+    /// @param compare The ordering of keys.
+    explicit SortedQuery(Scene* const scene, Compare compare = Compare{});
+
+    /// @brief Deleted default constructor.
+    SortedQuery() = delete;
+
+    /// @brief Stops listening for changes.
+    /// @details Asserts the scene still has its registry. Release builds skip the disconnect
+    ///          instead, since the signals went away with the registry.
+    ~SortedQuery();
+
+    // Delete copy and move operations since the registry signals point at this instance
+    SortedQuery(const SortedQuery&) = delete;
+    SortedQuery& operator=(const SortedQuery&) = delete;
+    SortedQuery(SortedQuery&&) = delete;
+    SortedQuery& operator=(SortedQuery&&) = delete;
+
+    // Public Methods
+
+    /// @brief Calls a function on every entity owning the key, in sorted order.
+    /// @param callback Called as callback(Entity*, KeyComponent&).
+    /// @details Repairs the order first. The callback must not add or remove the key.
+    template<typename Func>
+    void Each(Func&& callback);
+
+    /// @brief Repairs the order after the changes reported since the last call.
+    void Refresh();
+
+    /// @brief Reports a key modified without going through registry patch() or replace().
+    /// @param entity The entity whose key changed.
+    void MarkDirty(const Entity* const entity);
+
+    /// @brief Gets the number of sorted entities, as of the last refresh.
+    inline size_t GetCount() const { return _order.size(); }
+
+    /// @brief Gets the number of full sorts done since construction, including the first one.
+    /// @details Stays low while changes are handled incrementally.
+    inline size_t GetFullSortCount() const { return _fullSortCount; }
+
+    /// @brief Gets the number of refreshes that merged the changed keys back in.
+    inline size_t GetMergeCount() const { return _mergeCount; }
+
+    /// @brief Gets the number of refreshes that insertion sorted the order within budget.
+    inline size_t GetInsertionSortCount() const { return _insertionSortCount; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    Scene* const _scene;                                ///< @brief The queried scene.
+    Compare _compare;                                   ///< @brief The ordering of keys.
+    entt::storage_for_t<KeyComponent>* _storage{nullptr}; ///< @brief The key pool, stable while the registry lives.
+
+    std::vector<entt::entity> _order;   ///< @brief Sorted entities, as of the last refresh.
+    std::vector<entt::entity> _added;   ///< @brief Entities that gained the key since the last refresh.
+    std::vector<entt::entity> _changed; ///< @brief Entities whose key changed since the last refresh.
+    std::vector<entt::entity> _removed; ///< @brief Entities that lost the key since the last refresh.
+
+    size_t _fullSortCount{0};      ///< @brief Number of full sorts done.
+    size_t _mergeCount{0};         ///< @brief Number of refreshes repaired by merging.
+    size_t _insertionSortCount{0}; ///< @brief Number of refreshes repaired by insertion sort.
+
+    // Private Methods
+
+    /// @brief Compares the keys of two entities.
+    bool IsBefore(const entt::entity lhs, const entt::entity rhs) const;
+
+    /// @brief Orders entities by handle value, for the change lists.
+    static inline bool IsHandleBefore(const entt::entity lhs, const entt::entity rhs)
+    {
+        return entt::to_integral(lhs) < entt::to_integral(rhs);
+    }
+
+    /// @brief Sorts entities by handle and drops duplicates, so they can be binary searched.
+    static void SortUniqueHandles(std::vector<entt::entity>& entities);
+
+    /// @brief Checks whether a handle is in a list sorted by SortUniqueHandles().
+    static bool ContainsHandle(const std::vector<entt::entity>& sorted, const entt::entity entity);
+
+    /// @brief Sorts a range of entities from scratch.
+    void FullSort(std::vector<entt::entity>& entities);
+
+    /// @brief Sorts the order in place, giving up once the move budget is spent.
+    /// @return True if the order is sorted, false if the budget ran out first.
+    bool TryInsertionSort();
+
+    /// @brief Records an entity that gained the key.
+    void OnConstruct(entt::registry& registry, const entt::entity entity);
+
+    /// @brief Records an entity whose key was patched or replaced.
+    void OnUpdate(entt::registry& registry, const entt::entity entity);
+
+    /// @brief Records that an entity lost the key.
+    void OnDestroy(entt::registry& registry, const entt::entity entity);
+};
+
+} // namespace velecs::ecs
+
+#include "velecs/ecs/SortedQuery.inl"
@@ -0,0 +1,191 @@
+#include "velecs/ecs/Component.hpp"
+#include "velecs/ecs/Entity.hpp"
+#include "velecs/ecs/Scene.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace velecs::ecs {
+
+// Constructors and Destructors
+
+template<typename KeyComponent, typename Compare>
+SortedQuery<KeyComponent, Compare>::SortedQuery(Scene* const scene, Compare compare)
+    : _scene(scene), _compare(std::move(compare))
+{
+    static_assert(std::is_base_of_v<Component, KeyComponent>, "KeyComponent must inherit from Component");
+    assert(_scene && "Sorted query requires a scene");
+
+    entt::registry& registry = _scene->GetRegistry();
+    _storage = &registry.template storage<KeyComponent>();
+    const entt::sparse_set& pool = *_storage;
+    _order.assign(pool.begin(), pool.end());
+    FullSort(_order);
+
+    registry.template on_construct<KeyComponent>().template connect<&SortedQuery::OnConstruct>(*this);
+    registry.template on_update<KeyComponent>().template connect<&SortedQuery::OnUpdate>(*this);
+    registry.template on_destroy<KeyComponent>().template connect<&SortedQuery::OnDestroy>(*this);
+}
+
+template<typename KeyComponent, typename Compare>
+SortedQuery<KeyComponent, Compare>::~SortedQuery()
+{
+    // GetRegistry() throws once the scene is cleaned up, which would terminate from here
+    assert(_scene->_registry.has_value() && "Sorted queries must be destroyed before their scene is cleaned up");
+    if (!_scene->_registry.has_value()) return;
+
+    entt::registry& registry = *_scene->_registry;
+    registry.template on_construct<KeyComponent>().disconnect(*this);
+    registry.template on_update<KeyComponent>().disconnect(*this);
+    registry.template on_destroy<KeyComponent>().disconnect(*this);
+}
+
+// Public Methods
+
+template<typename KeyComponent, typename Compare>
+template<typename Func>
+void SortedQuery<KeyComponent, Compare>::Each(Func&& callback)
+{
+    Refresh();
+    for (const entt::entity entity : _order)
+    {
+        KeyComponent& key = _storage->get(entity);
+        callback(key.GetOwner(), key);
+    }
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::Refresh()
+{
+    if (_added.empty() && _changed.empty() && _removed.empty()) return;
+
+    SortUniqueHandles(_added);
+    SortUniqueHandles(_changed);
+    SortUniqueHandles(_removed);
+
+    // Entities removed and added back within one refresh still have their old entry
+    const auto isStale = [this](const entt::entity entity) {
+        return !_storage->contains(entity) || ContainsHandle(_removed, entity);
+    };
+
+    if ((_added.size() + _changed.size()) * MERGE_DIVISOR <= _order.size())
+    {
+        // Pull the changed keys out, sort them on their own and merge them back in
+        _order.erase(std::remove_if(_order.begin(), _order.end(), [this, &isStale](const entt::entity entity) {
+            return isStale(entity) || ContainsHandle(_changed, entity);
+        }), _order.end());
+
+        std::vector<entt::entity>& moved = _changed;
+        moved.insert(moved.end(), _added.begin(), _added.end());
+        SortUniqueHandles(moved);
+        moved.erase(std::remove_if(moved.begin(), moved.end(), [this](const entt::entity entity) {
+            return !_storage->contains(entity);
+        }), moved.end());
+        std::sort(moved.begin(), moved.end(), [this](const entt::entity lhs, const entt::entity rhs) { return IsBefore(lhs, rhs); });
+
+        const size_t middle = _order.size();
+        _order.insert(_order.end(), moved.begin(), moved.end());
+        std::inplace_merge(_order.begin(), _order.begin() + middle, _order.end(),
+            [this](const entt::entity lhs, const entt::entity rhs) { return IsBefore(lhs, rhs); });
+        ++_mergeCount;
+    }
+    else
+    {
+        // Most keys moved, usually a little, so repair the order where it stands
+        if (!_removed.empty())
+        {
+            _order.erase(std::remove_if(_order.begin(), _order.end(), isStale), _order.end());
+        }
+        for (const entt::entity entity : _added)
+        {
+            if (_storage->contains(entity)) _order.push_back(entity);
+        }
+        if (TryInsertionSort()) ++_insertionSortCount;
+        else FullSort(_order);
+    }
+
+    _added.clear();
+    _changed.clear();
+    _removed.clear();
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::MarkDirty(const Entity* const entity)
+{
+    assert(entity && entity->GetScene() == _scene && "Entity must belong to the queried scene");
+    _changed.push_back(entity->GetHandle());
+}
+
+// Private Methods
+
+template<typename KeyComponent, typename Compare>
+bool SortedQuery<KeyComponent, Compare>::IsBefore(const entt::entity lhs, const entt::entity rhs) const
+{
+    return _compare(std::as_const(*_storage).get(lhs), std::as_const(*_storage).get(rhs));
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::SortUniqueHandles(std::vector<entt::entity>& entities)
+{
+    std::sort(entities.begin(), entities.end(), &IsHandleBefore);
+    entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+}
+
+template<typename KeyComponent, typename Compare>
+bool SortedQuery<KeyComponent, Compare>::ContainsHandle(const std::vector<entt::entity>& sorted, const entt::entity entity)
+{
+    return std::binary_search(sorted.begin(), sorted.end(), entity, &IsHandleBefore);
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::FullSort(std::vector<entt::entity>& entities)
+{
+    std::sort(entities.begin(), entities.end(), [this](const entt::entity lhs, const entt::entity rhs) { return IsBefore(lhs, rhs); });
+    ++_fullSortCount;
+}
+
+template<typename KeyComponent, typename Compare>
+bool SortedQuery<KeyComponent, Compare>::TryInsertionSort()
+{
+    size_t budget = _order.size() * INSERTION_BUDGET;
+    for (size_t i = 1; i < _order.size(); ++i)
+    {
+        const entt::entity entity = _order[i];
+        size_t j = i;
+        while (j > 0 && IsBefore(entity, _order[j - 1]))
+        {
+            if (budget == 0)
+            {
+                // Put the entity back so the order stays a permutation for the full sort
+                _order[j] = entity;
+                return false;
+            }
+            --budget;
+            _order[j] = _order[j - 1];
+            --j;
+        }
+        _order[j] = entity;
+    }
+    return true;
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::OnConstruct(entt::registry&, const entt::entity entity)
+{
+    _added.push_back(entity);
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::OnUpdate(entt::registry&, const entt::entity entity)
+{
+    _changed.push_back(entity);
+}
+
+template<typename KeyComponent, typename Compare>
+void SortedQuery<KeyComponent, Compare>::OnDestroy(entt::registry&, const entt::entity entity)
+{
+    _removed.push_back(entity);
+}
+
+} // namespace velecs::ecs
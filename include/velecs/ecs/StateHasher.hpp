@@ -0,0 +1,122 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace velecs::ecs {
+
+/// @class StateHasher
+/// @brief Streaming 64-bit hash used to fingerprint scene state.
+///
+/// Follows the xxHash64 layout: input is consumed in 32-byte stripes by four independent
+/// accumulator lanes, which keeps the multiply chains out of each other's way and lets the
+/// compiler pipeline or vectorize the inner loop. Data can be fed in any number of Update()
+/// calls; the result only depends on the concatenated bytes.
+///
+/// Values are hashed as their in-memory bytes, so hashes are only comparable between builds
+/// of the same architecture and floating point settings, which lockstep peers share anyway.
+class StateHasher {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a hasher.
+    /// @param seed Seed mixed into every lane.
+    explicit StateHasher(const uint64_t seed = 0);
+
+    /// @brief Default destructor.
+    ~StateHasher() = default;
+
+    // Public Methods
+
+    /// @brief Feeds raw bytes into the hash.
+    /// @param data Pointer to the bytes.
+    /// @param size Number of bytes.
+    void Update(const void* const data, const size_t size);
+
+    /// @brief Feeds a trivially copyable value into the hash.
+    /// @tparam T The value type. Must be trivially copyable and free of padding.
+    /// @param value The value to hash.
+    template<typename T>
+    inline void Update(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be hashed as bytes");
+        Update(&value, sizeof(T));
+    }
+
+    /// @brief Feeds an entity handle into the hash.
+    /// @param handle The handle to hash. Null handles hash like any other value.
+    inline void Update(const entt::entity handle) { Update(entt::to_integral(handle)); }
+
+    /// @brief Computes the hash of everything fed so far.
+    /// @return The 64-bit hash. The hasher may keep receiving data afterwards.
+    uint64_t Finalize() const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    static const size_t STRIPE_SIZE = 32;
+
+    std::array<uint64_t, 4> _lanes;              ///< @brief Independent accumulator lanes.
+    std::array<unsigned char, STRIPE_SIZE> _tail; ///< @brief Bytes not yet forming a full stripe.
+    size_t _tailSize{0};                         ///< @brief Number of bytes buffered in _tail.
+    uint64_t _totalSize{0};                      ///< @brief Number of bytes fed so far.
+    const uint64_t _seed;                        ///< @brief Seed the lanes were initialized with.
+
+    // Private Methods
+
+    /// @brief Consumes one full stripe into the four lanes.
+    void ConsumeStripe(const unsigned char* const stripe);
+};
+
+/// @brief Detects components that contribute their values to scene state hashes.
+/// @details A component opts in by providing `void HashState(StateHasher& hasher) const`
+///          that feeds every field that is part of the simulation state. Pointers must be
+///          hashed through stable identities such as entity handles, never as addresses.
+template<typename T, typename = void>
+struct HasHashState : std::false_type {};
+
+template<typename T>
+struct HasHashState<T, std::void_t<decltype(std::declval<const T&>().HashState(std::declval<StateHasher&>()))>>
+    : std::true_type {};
+
+/// @struct StateHash
+/// @brief Fingerprint of a scene's registry, with one sub-hash per pool.
+struct StateHash {
+    /// @brief Fingerprint of a single component or tag pool.
+    struct PoolHash {
+        entt::id_type id{0};   ///< @brief EnTT type id of the pool.
+        std::string name;      ///< @brief Type name of the pool's component or tag.
+        size_t size{0};        ///< @brief Number of entities in the pool.
+        bool hasValues{false}; ///< @brief Whether component values were hashed, not just membership.
+        uint64_t hash{0};      ///< @brief Hash of the pool's entities and values.
+    };
+
+    uint64_t combined{0};        ///< @brief Hash of every pool hash, in pool id order.
+    std::vector<PoolHash> pools; ///< @brief Per-pool hashes sorted by pool id.
+
+    /// @brief Finds the first pool that differs from another state hash.
+    /// @param other The state hash to compare against, e.g. from a peer.
+    /// @param outIndex Set to the index into pools of the first mismatch.
+    /// @return True if a mismatch was found, false if both hashes cover identical pools.
+    /// @details Pools are sorted by id on both sides, so a pool present on only one side
+    ///          shows up as a mismatch at its sorted position.
+    bool TryFindFirstMismatch(const StateHash& other, size_t& outIndex) const;
+
+    inline bool operator==(const StateHash& other) const { return combined == other.combined; }
+    inline bool operator!=(const StateHash& other) const { return combined != other.combined; }
+};
+
+} // namespace velecs::ecs
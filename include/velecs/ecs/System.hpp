@@ -7,10 +7,21 @@ using velecs::common::Context;
 
 #include <entt/entt.hpp>
 
+#include <chrono>
+
 namespace velecs::ecs {
 
 class Scene;
 
+/// @struct SystemTimings
+/// @brief Wall-clock time a system spent in each processing phase during its last run.
+/// @details Only recorded when VELECS_ECS_STATS_ENABLED is set, otherwise all zero.
+struct SystemTimings {
+    std::chrono::nanoseconds process{0};        ///< @brief Duration of the last Process() call.
+    std::chrono::nanoseconds processPhysics{0}; ///< @brief Duration of the last ProcessPhysics() call.
+    std::chrono::nanoseconds processGUI{0};     ///< @brief Duration of the last ProcessGUI() call.
+};
+
 /// @class System
 /// @brief Base class for all ECS systems that process entities and their components.
 class System {
@@ -55,6 +66,14 @@ public:
     ///          This provides a lightweight way to temporarily deactivate system behavior.
     inline void SetEnabled(bool enabled) { _enabled = enabled; }
 
+    /// @brief Gets how long this system took in each phase during its last run.
+    /// @return Per-phase timings recorded by the owning scene.
+    inline const SystemTimings& GetTimings() const { return _timings; }
+
+    /// @brief Gets the scene the system is registered with.
+    /// @return The owning scene, or nullptr before the system is added to one.
+    inline Scene* GetScene() const { return _scene; }
+
 protected:
     // Protected Fields
 
@@ -110,6 +129,8 @@ private:
     // Private Fields
 
     bool _enabled{true}; ///< @brief Whether this system is currently enabled for processing.
+    SystemTimings _timings; ///< @brief Per-phase timings, written by the owning scene.
+    Scene* _scene{nullptr}; ///< @brief The owning scene, set before Init() is called.
 
     // Private Methods
 };
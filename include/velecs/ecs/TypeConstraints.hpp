@@ -1,5 +1,7 @@
 #pragma once
 
+#include "velecs/ecs/ComponentTraits.hpp"
+
 #include <type_traits>
 
 namespace velecs::ecs {
@@ -89,6 +91,9 @@ constexpr void validate_component() {
     
     static_assert(!std::is_abstract_v<T>, 
         "Cannot use abstract component types. Use a concrete derived class instead.");
+
+    static_assert(ComponentTraits<T>::pageSize > 0 && (ComponentTraits<T>::pageSize & (ComponentTraits<T>::pageSize - 1)) == 0,
+        "ComponentTraits pageSize must be a non-zero power of two.");
 }
 
 /// @brief Component constraint that ensures components have data AND inherit from Component
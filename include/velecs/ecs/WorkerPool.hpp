@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace velecs::ecs {
+
+/// @class WorkerPool
+/// @brief Fixed set of worker threads used to run parallel queries and systems.
+///
+/// Threads are started on the first ParallelFor() call, so worlds that never run parallel work
+/// never pay for them. The calling thread takes part in every ParallelFor() and the call
+/// returns once every task has finished, so tasks may safely reference the caller's stack.
+class WorkerPool {
+public:
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Creates a pool with the given number of worker threads.
+    /// @param workerCount Threads besides the caller. Zero runs every task on the caller.
+    explicit WorkerPool(const size_t workerCount = GetDefaultWorkerCount());
+
+    /// @brief Stops and joins every worker thread.
+    ~WorkerPool();
+
+    // Delete copy and move operations since workers hold a pointer to the pool
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    // Public Methods
+
+    /// @brief Gets one less than the number of hardware threads, leaving room for the caller.
+    static size_t GetDefaultWorkerCount();
+
+    /// @brief Gets the number of threads that run tasks, including the caller.
+    inline size_t GetThreadCount() const { return _workerCount + 1; }
+
+    /// @brief Gets the index of the calling thread within its pool.
+    /// @return 1 to the worker count on worker threads, 0 on any other thread, including the
+    ///         thread calling ParallelFor().
+    /// @details Lets tasks pick a per-thread slot, e.g. in an array sized by GetThreadCount().
+    static size_t GetCurrentThreadIndex();
+
+    /// @brief Gets the pool the calling worker thread belongs to.
+    /// @return nullptr on any thread that is not a worker, including the thread calling
+    ///         ParallelFor().
+    /// @details Tells apart threads sharing an index, e.g. workers of two different worlds.
+    static const WorkerPool* GetCurrentPool();
+
+    /// @brief Runs tasks [0, taskCount) across the pool and waits for all of them.
+    /// @param taskCount Number of tasks to run.
+    /// @param task Callback invoked once per task index, from any pool thread.
+    /// @details Tasks are claimed dynamically, so which thread runs which task is not fixed.
+    ///          Must not be called from inside a task.
+    void ParallelFor(const size_t taskCount, const std::function<void(size_t)>& task);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    const size_t _workerCount;         ///< @brief Threads besides the caller.
+    std::vector<std::thread> _threads; ///< @brief Worker threads, started lazily.
+
+    std::mutex _mutex;                   ///< @brief Guards the job fields below.
+    std::condition_variable _wakeup;     ///< @brief Signals a new job or shutdown to workers.
+    std::condition_variable _finished;   ///< @brief Signals the caller that workers are done.
+    const std::function<void(size_t)>* _task{nullptr}; ///< @brief Task of the current job.
+    size_t _taskCount{0};                ///< @brief Number of tasks in the current job.
+    uint64_t _generation{0};             ///< @brief Incremented for every new job.
+    size_t _busyWorkers{0};              ///< @brief Workers still running the current job.
+    bool _stopping{false};               ///< @brief Set when the pool is shutting down.
+
+    std::atomic<size_t> _nextTask{0};    ///< @brief Next unclaimed task index.
+
+    // Private Methods
+
+    /// @brief Worker thread loop.
+    /// @param threadIndex Index reported by GetCurrentThreadIndex() on this thread.
+    void Run(const size_t threadIndex);
+
+    /// @brief Claims and runs tasks of the current job until none are left.
+    void RunTasks();
+};
+
+} // namespace velecs::ecs
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "velecs/ecs/WorkerPool.hpp"
+
 #include <velecs/common/Uuid.hpp>
 using velecs::common::Uuid;
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <typeinfo>
 #include <typeindex>
@@ -28,6 +31,9 @@ public:
 
     std::unique_ptr<SceneManager> scenes{nullptr};
 
+    /// @brief Threads used by parallel queries. Replace before running any to resize the pool.
+    std::unique_ptr<WorkerPool> workers{nullptr};
+
     // Constructors and Destructors
 
     /// @brief Default constructor.
@@ -52,6 +58,13 @@ public:
     template<typename StorageT, typename ObjectT, typename... Args>
     ObjectT* CreateAs(Args&&... args);
 
+    /// @brief Reserves storage for additional objects of a type.
+    /// @tparam ObjectT The type of object about to be created.
+    /// @param count Number of objects about to be created.
+    /// @details Avoids repeated rehashing when many objects are created in one batch.
+    template<typename ObjectT>
+    void Reserve(const size_t count);
+
     /// @brief Attempts to retrieve an object by type and UUID.
     /// @tparam ObjectT The type of object to retrieve.
     /// @param uuid The UUID of the object to find.
@@ -73,6 +86,15 @@ public:
     template<typename ObjectT>
     bool TryRemove(const Uuid& uuid);
 
+    /// @brief Removes many objects of one type in a single pass.
+    /// @tparam ObjectT The type of objects to remove.
+    /// @param uuids The UUIDs of the objects to remove. Unknown UUIDs are skipped.
+    /// @param outRemoved Receives ownership of the removed objects, or null to destroy them here.
+    /// @return Number of objects removed.
+    /// @details Looks the type up once instead of once per object, for bulk teardown.
+    template<typename ObjectT>
+    size_t RemoveBatch(const std::vector<Uuid>& uuids, std::vector<ObjectStorage>* const outRemoved = nullptr);
+
     /// @brief Gets the number of objects of a specific type.
     /// @tparam ObjectT The type of object to count.
     /// @return Number of objects of the specified type.
@@ -83,6 +105,11 @@ public:
     /// @return Total number of managed objects.
     size_t GetTotalCount() const;
 
+    /// @brief Shrinks every object map to fit its current size.
+    /// @return Estimated number of bytes released.
+    /// @details Maps keep their peak bucket count after mass removals until this is called.
+    size_t Compact();
+
     /// @brief Checks if any objects of the specified type exist.
     /// @tparam ObjectT The type to check for.
     /// @return True if any objects of this type exist, false otherwise.
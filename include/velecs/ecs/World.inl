@@ -6,7 +6,7 @@ namespace velecs::ecs {
 // Constructors and Destructors
 
 World::World()
-    : scenes(std::make_unique<SceneManager>(this)) {}
+    : scenes(std::make_unique<SceneManager>(this)), workers(std::make_unique<WorkerPool>()) {}
 
 // Public Methods
 
@@ -37,6 +37,15 @@ ObjectT* World::CreateAs(Args&&... args)
     return obj;
 }
 
+template<typename ObjectT>
+void World::Reserve(const size_t count)
+{
+    static_assert(std::is_base_of_v<Object, ObjectT>, "ObjectT must inherit from Object");
+
+    auto& typeMap = _objects[std::type_index(typeid(ObjectT))];
+    typeMap.reserve(typeMap.size() + count);
+}
+
 template<typename ObjectT>
 ObjectT* World::TryGet(const Uuid& uuid)
 {
@@ -97,6 +106,33 @@ bool World::TryRemove(const Uuid& uuid)
     return true;
 }
 
+template<typename ObjectT>
+size_t World::RemoveBatch(const std::vector<Uuid>& uuids, std::vector<ObjectStorage>* const outRemoved)
+{
+    static_assert(std::is_base_of_v<Object, ObjectT>, "ObjectT must inherit from Object");
+
+    auto typeIt = _objects.find(std::type_index(typeid(ObjectT)));
+    if (typeIt == _objects.end()) return 0;
+
+    size_t removed = 0;
+    if (outRemoved) outRemoved->reserve(outRemoved->size() + uuids.size());
+    for (const Uuid& uuid : uuids)
+    {
+        auto node = typeIt->second.extract(uuid);
+        if (node.empty()) continue;
+
+        if (outRemoved) outRemoved->push_back(std::move(node.mapped()));
+        ++removed;
+    }
+
+    // Clean up empty type maps to avoid memory bloat
+    if (typeIt->second.empty()) {
+        _objects.erase(typeIt);
+    }
+
+    return removed;
+}
+
 template<typename ObjectT>
 size_t World::GetCount() const
 {
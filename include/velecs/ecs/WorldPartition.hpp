@@ -0,0 +1,259 @@
+#pragma once
+
+#include <velecs/math/Vec3.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace velecs::ecs {
+
+class Entity;
+class Scene;
+
+/// @class WorldPartition
+/// @brief Splits a scene into cubic cells and streams whole cells to and from disk around a focus point.
+///
+/// Every root entity (a Transform without a parent) belongs to the cell containing its position,
+/// together with its whole subtree. Update() keeps the cells within the streaming radius of the
+/// focus loaded and unloads the others:
+///  - Unloading encodes the cell on the frame thread, destroys its entities in one batch and hands
+///    the bytes to the partition's I/O thread, which replaces the cell file atomically.
+///  - Loading reads the cell file on the I/O thread. The frame thread then creates the cell's
+///    entities in batches, never more than the spawn budget per Update(), so crossing into a dense
+///    area spreads its creation over several frames instead of stalling one.
+///
+/// Only component types with a codec (`Serialize(BinaryWriter&) const` and
+/// `Deserialize(BinaryReader&)`) and tags are written to disk; other components are dropped with a
+/// warning. Call ComponentRegistry::Register<T>() for every streamed type before the first load so
+/// cell files written by earlier sessions can be read. Loaded entities are new objects: their names
+/// are kept but their UUIDs are not, and pointers to unloaded entities dangle.
+///
+/// Roots spawned or moved by gameplay are picked up by Rebuild(). The partition must be destroyed
+/// before its scene exits.
+///
+/// @code
+/// WorldPartition partition(scene, 64.0f, "saves/cells");
+/// partition.Rebuild();
+/// // Every frame
+/// partition.Update(player->GetTransform().GetPos());
+/// @endcode
+class WorldPartition {
+public:
+    // Public Fields
+
+    /// @struct CellKey
+    /// @brief Integer coordinates of a cell.
+    struct CellKey {
+        int32_t x{0}; ///< @brief Cell index along the X axis.
+        int32_t y{0}; ///< @brief Cell index along the Y axis.
+        int32_t z{0}; ///< @brief Cell index along the Z axis.
+
+        inline bool operator==(const CellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+        inline bool operator!=(const CellKey& other) const { return !(*this == other); }
+    };
+
+    /// @struct CellKeyHash
+    /// @brief Hash functor so cell keys can be used in unordered containers.
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const;
+    };
+
+    /// @brief Default maximum number of entities created per Update().
+    static const size_t DEFAULT_SPAWN_BUDGET = 512;
+
+    // Constructors and Destructors
+
+    /// @brief Creates a partition of the scene and starts its I/O thread.
+    /// @param scene The scene to partition. Must outlive the partition.
+    /// @param cellSize Edge length of a cell in world units. Must be positive.
+    /// @param directory Directory holding the cell files. Created if missing.
+    /// @details Cell files already present in the directory are treated as unloaded cells.
+    WorldPartition(Scene* const scene, const float cellSize, const std::string& directory);
+
+    /// @brief Deleted default constructor.
+    WorldPartition() = delete;
+
+    /// @brief Finishes every pending cell write and stops the I/O thread.
+    /// @details Cells that are still loaded are not saved.
+    ~WorldPartition();
+
+    // Delete copy and move operations since the partition owns a running thread
+    WorldPartition(const WorldPartition&) = delete;
+    WorldPartition& operator=(const WorldPartition&) = delete;
+    WorldPartition(WorldPartition&&) = delete;
+    WorldPartition& operator=(WorldPartition&&) = delete;
+
+    // Public Methods
+
+    /// @brief Gets the cell containing a position.
+    CellKey GetCellKey(const math::Vec3& pos) const;
+
+    /// @brief Assigns every root entity of the scene to the cell containing its position.
+    /// @return Number of roots assigned.
+    /// @details Call after creating the initial world and whenever roots may have been spawned or
+    ///          moved across cells. A root whose target cell is streamed out stays in its previous
+    ///          cell, or is left unassigned (never streamed) if it had none.
+    size_t Rebuild();
+
+    /// @brief Streams cells around the focus point.
+    /// @param focus Position the streaming radius is centered on, e.g. the player or camera.
+    /// @details Applies finished reads, unloads cells outside the radius, requests loads for cells
+    ///          inside it, then creates up to the spawn budget of pending entities.
+    void Update(const math::Vec3& focus);
+
+    /// @brief Requests a cell to be loaded.
+    /// @param key The cell to load.
+    /// @return True if a load was started or the cell was empty, false if it is already loaded or loading.
+    bool TryLoadCell(const CellKey& key);
+
+    /// @brief Saves a cell to disk and destroys its entities.
+    /// @param key The cell to unload.
+    /// @return True if the cell was loaded or loading, false if it is not resident.
+    /// @details A cell that is still loading is abandoned without writing, its file is unchanged.
+    bool TryUnloadCell(const CellKey& key);
+
+    /// @brief Checks whether every entity of a cell is live in the scene.
+    bool IsCellLoaded(const CellKey& key) const;
+
+    /// @brief Gets the number of fully loaded cells.
+    size_t GetLoadedCellCount() const;
+
+    /// @brief Gets the number of entities read from disk that are still waiting to be created.
+    inline size_t GetPendingSpawnCount() const { return _pendingSpawnCount; }
+
+    /// @brief Blocks until the I/O thread has finished every queued read and write.
+    /// @details Finished reads are applied by the next Update().
+    void Flush();
+
+    /// @brief Sets the number of cells loaded in each direction around the focus cell.
+    inline void SetStreamingRadius(const uint32_t radius) { _streamingRadius = radius; }
+
+    /// @brief Gets the number of cells loaded in each direction around the focus cell.
+    inline uint32_t GetStreamingRadius() const { return _streamingRadius; }
+
+    /// @brief Sets the maximum number of entities created per Update().
+    /// @param budget Entities per frame. Must be positive.
+    void SetSpawnBudget(const size_t budget);
+
+    /// @brief Gets the maximum number of entities created per Update().
+    inline size_t GetSpawnBudget() const { return _spawnBudget; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @brief Version written at the start of every cell file.
+    static const uint32_t CELL_FORMAT_VERSION = 1;
+
+    /// @brief Parent index stored for roots in a cell file.
+    static const uint32_t NO_PARENT = UINT32_MAX;
+
+    /// @enum CellState
+    /// @brief Residency of a cell.
+    enum class CellState {
+        Unloaded, ///< @brief Only on disk, or empty.
+        Loading,  ///< @brief Waiting for the I/O thread to read the file.
+        Spawning, ///< @brief Read, entities are being created under the spawn budget.
+        Loaded,   ///< @brief Every entity is live.
+    };
+
+    /// @struct Cell
+    /// @brief Frame-thread state of a single cell.
+    struct Cell {
+        CellState state{CellState::Unloaded};
+        std::vector<Entity*> roots;      ///< @brief Root entities owned by the cell.
+        std::vector<unsigned char> data; ///< @brief File contents while spawning.
+        size_t position{0};              ///< @brief Read offset into data while spawning.
+        uint32_t remaining{0};           ///< @brief Entities left to create while spawning.
+        std::vector<Entity*> spawned;    ///< @brief Entities created so far, indexed by file order.
+    };
+
+    /// @struct IoJob
+    /// @brief A read or write handed to the I/O thread.
+    struct IoJob {
+        CellKey key;
+        bool write{false};
+        std::vector<unsigned char> data; ///< @brief Bytes to write, unused for reads.
+    };
+
+    /// @struct IoResult
+    /// @brief A finished read handed back to the frame thread.
+    struct IoResult {
+        CellKey key;
+        bool ok{false};                  ///< @brief False if the file could not be read.
+        std::vector<unsigned char> data; ///< @brief File contents.
+    };
+
+    Scene* const _scene;          ///< @brief The partitioned scene.
+    const float _cellSize;        ///< @brief Edge length of a cell in world units.
+    const std::string _directory; ///< @brief Directory holding the cell files.
+
+    uint32_t _streamingRadius{1};               ///< @brief Cells loaded in each direction around the focus.
+    size_t _spawnBudget{DEFAULT_SPAWN_BUDGET}; ///< @brief Maximum entities created per Update().
+
+    std::unordered_map<CellKey, Cell, CellKeyHash> _cells;        ///< @brief Every cell seen so far.
+    std::unordered_set<CellKey, CellKeyHash> _cellsOnDisk;         ///< @brief Cells that have a file.
+    std::unordered_map<const Entity*, CellKey> _rootCells;         ///< @brief Cell of each assigned root.
+    std::deque<CellKey> _spawnQueue;                               ///< @brief Cells in the Spawning state, oldest first.
+    size_t _pendingSpawnCount{0};                                  ///< @brief Entities left to create across cells.
+
+    std::mutex _mutex;                  ///< @brief Guards the I/O fields below.
+    std::condition_variable _wakeup;    ///< @brief Signals a queued job or shutdown to the I/O thread.
+    std::condition_variable _idle;      ///< @brief Signals Flush() that the job queue drained.
+    std::deque<IoJob> _jobs;            ///< @brief Jobs in submission order.
+    std::vector<IoResult> _results;     ///< @brief Finished reads not yet applied.
+    bool _busy{false};                  ///< @brief Set while the I/O thread runs a job.
+    bool _stopping{false};              ///< @brief Set when the partition is shutting down.
+
+    std::thread _thread;                ///< @brief Thread reading and writing cell files.
+
+    // Private Methods
+
+    /// @brief I/O thread loop. Jobs run in submission order, so a read always sees earlier writes.
+    void Run();
+
+    /// @brief Queues a job for the I/O thread.
+    void Submit(IoJob&& job);
+
+    /// @brief Moves finished reads into the spawn queue.
+    void ApplyResults();
+
+    /// @brief Creates pending entities until the spawn budget is spent.
+    void SpawnPending();
+
+    /// @brief Destroys the entities created so far for a cell that is still spawning.
+    void AbandonSpawn(const CellKey& key, Cell& cell);
+
+    /// @brief Walks a whole cell file without creating anything.
+    /// @return False if the version is unsupported, a parent does not precede its child, an
+    ///         entity has no Transform, or the entries do not add up to the file's size.
+    static bool IsCellFileValid(const std::vector<unsigned char>& data);
+
+    /// @brief Encodes the subtrees of the cell's roots as a cell file.
+    /// @param cell The cell to encode.
+    /// @param outEntities Receives every encoded entity.
+    /// @return The file contents.
+    std::vector<unsigned char> Encode(Cell& cell, std::vector<Entity*>& outEntities);
+
+    /// @brief Gets the path of a cell's file.
+    std::string GetCellPath(const CellKey& key) const;
+
+    /// @brief Atomically replaces a file with the given bytes.
+    static bool TryWriteFile(const std::string& path, const std::vector<unsigned char>& data);
+
+    /// @brief Reads a whole file.
+    static bool TryReadFile(const std::string& path, std::vector<unsigned char>& outData);
+};
+
+} // namespace velecs::ecs
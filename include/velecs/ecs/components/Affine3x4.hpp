@@ -0,0 +1,121 @@
+#pragma once
+
+#include "velecs/ecs/Simd.hpp"
+
+#include <velecs/math/Vec3.hpp>
+#include <velecs/math/Quat.hpp>
+#include <velecs/math/Mat4.hpp>
+
+#include <cstddef>
+
+namespace velecs::ecs {
+
+/// @struct Affine3x4
+/// @brief Affine transformation stored as the top three rows of a 4x4 matrix.
+/// @details TRS matrices always end with the row (0, 0, 0, 1), so it is implied instead of
+///          stored: 48 bytes against 64 for a Mat4. Each row holds three linear terms followed
+///          by one translation term and is 16 byte aligned, so a row fits one SSE register.
+///          Convert to Mat4 with ToMat4() only where a full matrix is needed.
+struct alignas(16) Affine3x4 {
+    using Vec3 = velecs::math::Vec3;
+    using Quat = velecs::math::Quat;
+    using Mat4 = velecs::math::Mat4;
+
+    // Public Fields
+
+    float rows[3][4]; ///< @brief Row-major terms, rows[row][3] is the translation.
+
+    /// @brief The transformation that changes nothing.
+    static const Affine3x4 IDENTITY;
+
+    // Public Methods
+
+    /// @brief Builds the matrix T * R * S from a translation, rotation and scale.
+    /// @param pos Translation.
+    /// @param rot Rotation, expected to be normalized.
+    /// @param scale Scale along each local axis.
+    static Affine3x4 FromTRS(const Vec3& pos, const Quat& rot, const Vec3& scale);
+
+    /// @brief Expands to a full 4x4 matrix.
+    Mat4 ToMat4() const;
+
+    /// @brief Computes the transformation that undoes this one.
+    /// @return The inverse, or IDENTITY if the matrix is singular (e.g. a zero scale).
+    Affine3x4 Inverse() const;
+
+    /// @brief Transforms a point, applying the translation.
+    inline Vec3 TransformPoint(const Vec3& point) const
+    {
+        Vec3 result;
+        result.x = rows[0][0] * point.x + rows[0][1] * point.y + rows[0][2] * point.z + rows[0][3];
+        result.y = rows[1][0] * point.x + rows[1][1] * point.y + rows[1][2] * point.z + rows[1][3];
+        result.z = rows[2][0] * point.x + rows[2][1] * point.y + rows[2][2] * point.z + rows[2][3];
+        return result;
+    }
+
+    /// @brief Transforms a direction, ignoring the translation. Rotation and scale still apply.
+    inline Vec3 TransformDirection(const Vec3& direction) const
+    {
+        Vec3 result;
+        result.x = rows[0][0] * direction.x + rows[0][1] * direction.y + rows[0][2] * direction.z;
+        result.y = rows[1][0] * direction.x + rows[1][1] * direction.y + rows[1][2] * direction.z;
+        result.z = rows[2][0] * direction.x + rows[2][1] * direction.y + rows[2][2] * direction.z;
+        return result;
+    }
+
+    /// @brief Transforms a range of points, applying the translation.
+    /// @param points The points to transform.
+    /// @param outPoints Receives the results. May be the same array as points.
+    /// @param count Number of points.
+    void TransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const;
+
+    /// @brief Transforms a range of directions, ignoring the translation.
+    /// @param directions The directions to transform.
+    /// @param outDirections Receives the results. May be the same array as directions.
+    /// @param count Number of directions.
+    void TransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const;
+
+    /// @brief Composes two transformations, applying rhs first.
+    /// @param rhs The inner transformation, e.g. a child's model matrix.
+    /// @return The combined transformation, e.g. the child's world matrix.
+    inline Affine3x4 operator*(const Affine3x4& rhs) const
+    {
+        Affine3x4 result;
+#if VELECS_ECS_SSE
+        const __m128 rhs0 = _mm_load_ps(rhs.rows[0]);
+        const __m128 rhs1 = _mm_load_ps(rhs.rows[1]);
+        const __m128 rhs2 = _mm_load_ps(rhs.rows[2]);
+        const __m128 rhs3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f); // The implied (0, 0, 0, 1) row
+        for (int i = 0; i < 3; ++i)
+        {
+            const __m128 row = _mm_load_ps(rows[i]);
+            __m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), rhs0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), rhs1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), rhs2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), rhs3));
+            _mm_store_ps(result.rows[i], sum);
+        }
+#else
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                result.rows[i][j] = rows[i][0] * rhs.rows[0][j]
+                                  + rows[i][1] * rhs.rows[1][j]
+                                  + rows[i][2] * rhs.rows[2][j];
+            }
+            result.rows[i][3] += rows[i][3];
+        }
+#endif
+        return result;
+    }
+
+private:
+    // Private Methods
+
+    /// @brief Shared loop of TransformPoints() and TransformDirections().
+    /// @param translation 1 to apply the translation, 0 to ignore it.
+    void TransformRange(const Vec3* const inputs, Vec3* const outputs, const size_t count, const float translation) const;
+};
+
+} // namespace velecs::ecs
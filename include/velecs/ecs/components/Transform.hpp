@@ -1,7 +1,10 @@
 #pragma once
 
 #include "velecs/ecs/Component.hpp"
+#include "velecs/ecs/BinaryStream.hpp"
 #include "velecs/ecs/Entity.hpp"
+#include "velecs/ecs/StateHasher.hpp"
+#include "velecs/ecs/components/Affine3x4.hpp"
 
 #include <velecs/common/Exceptions.hpp>
 
@@ -27,6 +30,8 @@ class TraversalRange;
 ///          hierarchy management. Provides cached matrix calculations for efficient
 ///          rendering transformations.
 class Transform : public Component {
+    friend class Scene; // Rebuilds hierarchy links when entities leave or rejoin the registry
+
 public:
     using Vec3 = velecs::math::Vec3;
     using Quat = velecs::math::Quat;
@@ -102,6 +107,64 @@ public:
     ///          Matrix is cached and only recalculated when hierarchy changes.
     Mat4 GetWorldMatrix() const;
 
+    /// @brief Gets the cached local-to-parent matrix in its compact affine form.
+    /// @return Reference to the cache, valid until the transform changes.
+    /// @details Same as GetModelMatrix() without expanding to a Mat4.
+    const Affine3x4& GetModelAffine() const;
+
+    /// @brief Gets the cached local-to-world matrix in its compact affine form.
+    /// @return Reference to the cache, valid until the transform or an ancestor changes.
+    /// @details Same as GetWorldMatrix() without expanding to a Mat4.
+    const Affine3x4& GetWorldAffine() const;
+
+    /// @brief Gets the world-to-local transformation matrix.
+    /// @return 4x4 inverse of GetWorldMatrix().
+    /// @details Computed on first use and cached until the world matrix changes.
+    Mat4 GetWorldInverseMatrix() const;
+
+    /// @brief Gets the cached world-to-local matrix in its compact affine form.
+    /// @return Reference to the cache, valid until the transform or an ancestor changes.
+    const Affine3x4& GetWorldInverseAffine() const;
+
+    // ========== Space Conversion ==========
+
+    /// @brief Converts a point from local to world space.
+    inline Vec3 TransformPoint(const Vec3& point) const { return GetWorldAffine().TransformPoint(point); }
+
+    /// @brief Converts a point from world to local space.
+    inline Vec3 InverseTransformPoint(const Vec3& point) const { return GetWorldInverseAffine().TransformPoint(point); }
+
+    /// @brief Converts a direction from local to world space. Translation is ignored, scale is not.
+    inline Vec3 TransformDirection(const Vec3& direction) const { return GetWorldAffine().TransformDirection(direction); }
+
+    /// @brief Converts a direction from world to local space. Translation is ignored, scale is not.
+    inline Vec3 InverseTransformDirection(const Vec3& direction) const { return GetWorldInverseAffine().TransformDirection(direction); }
+
+    /// @brief Converts a range of points from local to world space.
+    /// @param points The local points.
+    /// @param outPoints Receives the world points. May be the same array as points.
+    /// @param count Number of points.
+    /// @details Resolves the world matrix once for the whole range.
+    void TransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const;
+
+    /// @brief Converts a range of points from world to local space.
+    /// @param points The world points.
+    /// @param outPoints Receives the local points. May be the same array as points.
+    /// @param count Number of points.
+    void InverseTransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const;
+
+    /// @brief Converts a range of directions from local to world space.
+    /// @param directions The local directions.
+    /// @param outDirections Receives the world directions. May be the same array as directions.
+    /// @param count Number of directions.
+    void TransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const;
+
+    /// @brief Converts a range of directions from world to local space.
+    /// @param directions The world directions.
+    /// @param outDirections Receives the local directions. May be the same array as directions.
+    /// @param count Number of directions.
+    void InverseTransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const;
+
     // ========== Parent Management ==========
 
     inline bool HasParent(const Entity* const parent) const { return _parent == parent; }
@@ -210,6 +273,24 @@ public:
     /// @details Traverses up the parent chain until reaching a transform with no parent.
     Entity* GetRoot() const;
 
+    /// @brief Feeds the local transform and hierarchy links into a state hash.
+    /// @param hasher The hasher to feed.
+    /// @details Parent and children are hashed by entity handle so equal scenes hash equally
+    ///          regardless of where their Entity objects live in memory. Cached matrices are
+    ///          derived data and are left out.
+    void HashState(StateHasher& hasher) const;
+
+    /// @brief Writes the local position, scale and rotation.
+    /// @param writer The writer to append to.
+    /// @details The hierarchy is not part of the codec, whoever restores a Transform also
+    ///          restores its parent and children.
+    void Serialize(BinaryWriter& writer) const;
+
+    /// @brief Reads the local position, scale and rotation written by Serialize().
+    /// @param reader The reader to consume from.
+    /// @details Leaves cached matrices dirty.
+    void Deserialize(BinaryReader& reader);
+
     // ========== Iterator Support ==========
 
     /// @brief Iterator type for range-based loops over children.
@@ -259,22 +340,29 @@ private:
     Entity* _parent{nullptr};                    /// @brief Parent entity (nullptr if root)
     std::vector<Entity*> _children;              /// @brief List of direct child entities
 
-    mutable bool isModelDirty{true};             /// @brief Flag indicating model matrix needs recalculation
-    mutable Mat4 cachedModelMat{Mat4::IDENTITY}; /// @brief Cached local-to-parent transformation matrix
+    mutable Affine3x4 cachedModelMat{Affine3x4::IDENTITY};        /// @brief Cached local-to-parent transformation matrix
+    mutable Affine3x4 cachedWorldMat{Affine3x4::IDENTITY};        /// @brief Cached local-to-world transformation matrix
+    mutable Affine3x4 cachedWorldInverseMat{Affine3x4::IDENTITY}; /// @brief Cached world-to-local transformation matrix
 
-    mutable bool isWorldDirty{true};             /// @brief Flag indicating world matrix needs recalculation
-    mutable Mat4 cachedWorldMat{Mat4::IDENTITY}; /// @brief Cached local-to-world transformation matrix
+    // The flags share the tail after the aligned matrices instead of padding before each one
+    mutable bool isModelDirty{true};        /// @brief Flag indicating model matrix needs recalculation
+    mutable bool isWorldDirty{true};        /// @brief Flag indicating world matrix needs recalculation
+    mutable bool isWorldInverseDirty{true}; /// @brief Flag indicating the inverse world matrix needs recalculation
 
     // Private Methods
 
     /// @brief Calculates the local-to-parent transformation matrix.
-    /// @return 4x4 TRS matrix combining translation, rotation, and scale.
-    math::Mat4 CalculateModel() const;
+    /// @return Affine TRS matrix combining translation, rotation, and scale.
+    Affine3x4 CalculateModel() const;
+
+    /// @brief Composes the local-to-parent matrix without recording counters.
+    /// @return Affine TRS matrix combining translation, rotation, and scale.
+    Affine3x4 ComposeModel() const;
 
     /// @brief Calculates the local-to-world transformation matrix.
-    /// @return 4x4 matrix representing world transformation.
+    /// @return Affine matrix representing world transformation.
     /// @details Multiplies parent's world matrix with this transform's model matrix.
-    math::Mat4 CalculateWorld() const;
+    Affine3x4 CalculateWorld() const;
 
     /// @brief Marks world matrix as dirty and propagates to all children.
     /// @details Called when this transform's world position might have changed.
@@ -283,6 +371,17 @@ private:
     /// @brief Marks both model and world matrices as dirty.
     /// @details Called when this transform's local properties change.
     void SetDirty();
+
+    /// @brief Counts this transform and all of its descendants.
+    /// @return Number of transforms in the subtree, including this one.
+    size_t GetSubtreeSize() const;
+
+    /// @brief Recomputes the world matrices of this transform and its whole subtree, top down.
+    /// @param parentWorld World matrix of the parent, identity for a root.
+    /// @return Number of model matrices recomputed along the way.
+    /// @details Used by Scene::PropagateTransforms() on worker threads. Records no counters
+    ///          so workers do not contend on them, the caller adds them up per work item.
+    size_t PropagateWorld(const Affine3x4& parentWorld) const;
 };
 
 /// @enum TraversalOrder
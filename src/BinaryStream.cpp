@@ -0,0 +1,63 @@
+#include "velecs/ecs/BinaryStream.hpp"
+
+#include <stdexcept>
+
+namespace velecs::ecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void BinaryWriter::Write(const void* const data, const size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    _buffer.insert(_buffer.end(), bytes, bytes + size);
+}
+
+void BinaryWriter::WriteString(const std::string& value)
+{
+    Write(static_cast<uint32_t>(value.size()));
+    Write(value.data(), value.size());
+}
+
+void BinaryReader::Read(void* const outData, const size_t size)
+{
+    Require(size);
+    std::memcpy(outData, _data + _position, size);
+    _position += size;
+}
+
+std::string BinaryReader::ReadString()
+{
+    const uint32_t size = Read<uint32_t>();
+    Require(size);
+    std::string value(reinterpret_cast<const char*>(_data + _position), size);
+    _position += size;
+    return value;
+}
+
+void BinaryReader::Skip(const size_t size)
+{
+    Require(size);
+    _position += size;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void BinaryReader::Require(const size_t size) const
+{
+    if (size > _size - _position)
+    {
+        throw std::runtime_error("Binary data ended unexpectedly, it is corrupt or from an incompatible version");
+    }
+}
+
+} // namespace velecs::ecs
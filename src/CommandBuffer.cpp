@@ -0,0 +1,49 @@
+#include "velecs/ecs/CommandBuffer.hpp"
+#include "velecs/ecs/Entity.hpp"
+
+namespace velecs::ecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void CommandBuffer::Spawn(std::function<void(Entity* const)> init)
+{
+    SceneCommand command;
+    command.type = SceneCommand::Type::Spawn;
+    command.callback = std::move(init);
+    _commands.push_back(std::move(command));
+}
+
+void CommandBuffer::Destroy(const Entity* const entity)
+{
+    assert(entity && "Entity must not be null");
+
+    SceneCommand command;
+    command.type = SceneCommand::Type::Destroy;
+    command.target = entity->GetUuid();
+    _commands.push_back(std::move(command));
+}
+
+void CommandBuffer::Update(const Entity* const entity, std::function<void(Entity* const)> update)
+{
+    assert(entity && "Entity must not be null");
+
+    SceneCommand command;
+    command.type = SceneCommand::Type::Update;
+    command.target = entity->GetUuid();
+    command.callback = std::move(update);
+    _commands.push_back(std::move(command));
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs::ecs
@@ -0,0 +1,52 @@
+#include "velecs/ecs/ComponentRegistry.hpp"
+
+namespace velecs::ecs {
+
+namespace {
+
+/// @brief Guards the ops table.
+std::mutex& GetMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+/// @brief Ops of every registered component type.
+std::unordered_map<entt::id_type, ComponentOps>& GetTable()
+{
+    static std::unordered_map<entt::id_type, ComponentOps> table;
+    return table;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+bool ComponentRegistry::TryGet(const entt::id_type id, const ComponentOps*& outOps)
+{
+    std::lock_guard<std::mutex> lock(GetMutex());
+    auto& table = GetTable();
+    auto it = table.find(id);
+    outOps = (it != table.end()) ? &it->second : nullptr;
+    return outOps != nullptr;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void ComponentRegistry::Insert(const entt::id_type id, ComponentOps&& ops)
+{
+    std::lock_guard<std::mutex> lock(GetMutex());
+    GetTable().try_emplace(id, std::move(ops));
+}
+
+} // namespace velecs::ecs
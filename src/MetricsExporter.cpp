@@ -0,0 +1,278 @@
+#include "velecs/ecs/MetricsExporter.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace velecs::ecs {
+
+namespace {
+
+/// @brief Gets the current steady clock time in nanoseconds.
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Escapes a label value as required by the OpenMetrics text format.
+std::string EscapeLabel(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '\\': escaped += "\\\\"; break;
+            case '"':  escaped += "\\\""; break;
+            case '\n': escaped += "\\n";  break;
+            default:   escaped += c;      break;
+        }
+    }
+    return escaped;
+}
+
+/// @brief Converts a duration to fractional seconds.
+double ToSeconds(const std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+/// @brief Writes the TYPE and HELP lines of a metric family.
+void WriteFamily(std::ostringstream& out, const char* name, const char* type, const char* help)
+{
+    out << "# TYPE " << name << ' ' << type << '\n';
+    out << "# HELP " << name << ' ' << help << '\n';
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+MetricsExporter::MetricsExporter(const Target target, const std::string& path, const std::chrono::milliseconds interval)
+    : _target(target), _path(path), _interval(interval)
+{
+    _thread = std::thread(&MetricsExporter::Run, this);
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_one();
+    if (_thread.joinable()) _thread.join();
+}
+
+// Public Methods
+
+bool MetricsExporter::IsSnapshotDue() const
+{
+    return NowNs() >= _nextDue.load(std::memory_order_relaxed);
+}
+
+bool MetricsExporter::TrySubmit(MetricsSnapshot&& snapshot)
+{
+    // Never block the frame thread, drop the snapshot if the exporter holds the lock
+    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return false;
+
+    _pending = std::move(snapshot);
+    lock.unlock();
+
+    _nextDue.store(NowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(_interval).count(),
+        std::memory_order_relaxed);
+    _wakeup.notify_one();
+    return true;
+}
+
+std::string MetricsExporter::Serialize(const MetricsSnapshot& snapshot)
+{
+    std::ostringstream out;
+
+    WriteFamily(out, "velecs_ecs_entities", "gauge", "Number of live entities in the scene.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        out << "velecs_ecs_entities{scene=\"" << EscapeLabel(scene.name) << "\"} " << scene.entityCount << '\n';
+    }
+
+    WriteFamily(out, "velecs_ecs_pool_size", "gauge", "Number of entities in a component or tag pool.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        for (const auto& pool : scene.pools)
+        {
+            out << "velecs_ecs_pool_size{scene=\"" << EscapeLabel(scene.name)
+                << "\",type=\"" << EscapeLabel(pool.name) << "\"} " << pool.size << '\n';
+        }
+    }
+
+    WriteFamily(out, "velecs_ecs_pool_capacity", "gauge", "Number of entities a pool can hold without growing.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        for (const auto& pool : scene.pools)
+        {
+            out << "velecs_ecs_pool_capacity{scene=\"" << EscapeLabel(scene.name)
+                << "\",type=\"" << EscapeLabel(pool.name) << "\"} " << pool.capacity << '\n';
+        }
+    }
+
+    WriteFamily(out, "velecs_ecs_system_duration_seconds", "gauge", "Duration of a system phase during its last run.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        for (const auto& system : scene.systems)
+        {
+            const std::string labels = "scene=\"" + EscapeLabel(scene.name) + "\",system=\"" + EscapeLabel(system.name) + "\"";
+            out << "velecs_ecs_system_duration_seconds{" << labels << ",phase=\"process\"} "
+                << ToSeconds(system.timings.process) << '\n';
+            out << "velecs_ecs_system_duration_seconds{" << labels << ",phase=\"physics\"} "
+                << ToSeconds(system.timings.processPhysics) << '\n';
+            out << "velecs_ecs_system_duration_seconds{" << labels << ",phase=\"gui\"} "
+                << ToSeconds(system.timings.processGUI) << '\n';
+        }
+    }
+
+    WriteFamily(out, "velecs_ecs_cleanup_destroyed", "counter", "Entities destroyed by cleanup phases.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        out << "velecs_ecs_cleanup_destroyed_total{scene=\"" << EscapeLabel(scene.name) << "\"} "
+            << scene.totalCleanupCount << '\n';
+    }
+
+    WriteFamily(out, "velecs_ecs_cleanup_last_destroyed", "gauge", "Entities destroyed by the last cleanup phase.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        out << "velecs_ecs_cleanup_last_destroyed{scene=\"" << EscapeLabel(scene.name) << "\"} "
+            << scene.lastCleanupCount << '\n';
+    }
+
+    WriteFamily(out, "velecs_ecs_frame_operations", "gauge", "Expensive internal operations during the last frame.");
+    for (const auto& scene : snapshot.scenes)
+    {
+        const std::string prefix = "velecs_ecs_frame_operations{scene=\"" + EscapeLabel(scene.name) + "\",operation=\"";
+        const SceneStats& stats = scene.frameStats;
+        out << prefix << "entity_lookups\"} " << stats.entityLookups << '\n';
+        out << prefix << "world_lookups\"} " << stats.worldLookups << '\n';
+        out << prefix << "validity_checks\"} " << stats.validityChecks << '\n';
+        out << prefix << "model_recomputes\"} " << stats.modelRecomputes << '\n';
+        out << prefix << "world_recomputes\"} " << stats.worldRecomputes << '\n';
+        out << prefix << "dirty_visits\"} " << stats.dirtyVisits << '\n';
+    }
+
+    WriteFamily(out, "velecs_ecs_scene_transitions", "counter", "Scene transitions processed.");
+    out << "velecs_ecs_scene_transitions_total " << snapshot.transitionCount << '\n';
+
+    WriteFamily(out, "velecs_ecs_scene_transition_duration_seconds", "gauge", "Duration of the last scene transition.");
+    out << "velecs_ecs_scene_transition_duration_seconds " << ToSeconds(snapshot.lastTransitionDuration) << '\n';
+
+    out << "# EOF\n";
+    return out.str();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void MetricsExporter::Run()
+{
+    while (true)
+    {
+        MetricsSnapshot snapshot;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeup.wait(lock, [this]() { return _stopping || _pending.has_value(); });
+            if (_stopping) return;
+            snapshot = std::move(*_pending);
+            _pending.reset();
+        }
+
+        if (!TryWrite(Serialize(snapshot)))
+        {
+            std::cerr << "[WARNING] Failed to export ECS metrics to '" << _path << "'." << std::endl;
+        }
+    }
+}
+
+bool MetricsExporter::TryWrite(const std::string& payload) const
+{
+    switch (_target)
+    {
+        case Target::File:       return TryWriteFile(payload);
+        case Target::UnixSocket: return TryWriteSocket(payload);
+    }
+    return false;
+}
+
+bool MetricsExporter::TryWriteFile(const std::string& payload) const
+{
+    const std::string tempPath = _path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!file) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, _path, error);
+    return !error;
+}
+
+bool MetricsExporter::TryWriteSocket(const std::string& payload) const
+{
+#if defined(_WIN32)
+    (void)payload;
+    return false;
+#else
+    sockaddr_un address{};
+    if (_path.size() >= sizeof(address.sun_path)) return false;
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, _path.c_str(), _path.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // A scraper that hung up must fail the send, not raise SIGPIPE and kill the host process
+#if defined(MSG_NOSIGNAL)
+    const int sendFlags = MSG_NOSIGNAL;
+#else
+    const int sendFlags = 0;
+    const int noSigPipe = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    size_t written = 0;
+    while (written < payload.size())
+    {
+        const ssize_t result = ::send(fd, payload.data() + written, payload.size() - written, sendFlags);
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+    }
+
+    ::close(fd);
+    return written == payload.size();
+#endif
+}
+
+} // namespace velecs::ecs
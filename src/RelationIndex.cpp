@@ -0,0 +1,113 @@
+#include "velecs/ecs/RelationIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace velecs::ecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+bool RelationIndex::TryAdd(const entt::entity source, const entt::entity target)
+{
+    if (Contains(source, target)) return false;
+
+    if (!_targets.contains(source)) _targets.emplace(source);
+    if (!_sources.contains(target)) _sources.emplace(target);
+    _targets.get(source).push_back(target);
+    _sources.get(target).push_back(source);
+    ++_edgeCount;
+    return true;
+}
+
+bool RelationIndex::TryRemove(const entt::entity source, const entt::entity target)
+{
+    if (!TryErase(_targets, source, target)) return false;
+
+    const bool mirrored = TryErase(_sources, target, source);
+    assert(mirrored && "Relation index out of sync, forward edge without its reverse edge");
+    (void)mirrored;
+
+    --_edgeCount;
+    return true;
+}
+
+bool RelationIndex::Contains(const entt::entity source, const entt::entity target) const
+{
+    // Search whichever side has the shorter list
+    const Edges& targets = GetTargets(source);
+    const Edges& sources = GetSources(target);
+    if (targets.size() <= sources.size())
+    {
+        return std::find(targets.begin(), targets.end(), target) != targets.end();
+    }
+    return std::find(sources.begin(), sources.end(), source) != sources.end();
+}
+
+const std::vector<entt::entity>& RelationIndex::GetTargets(const entt::entity source) const
+{
+    return _targets.contains(source) ? _targets.get(source) : GetEmpty();
+}
+
+const std::vector<entt::entity>& RelationIndex::GetSources(const entt::entity target) const
+{
+    return _sources.contains(target) ? _sources.get(target) : GetEmpty();
+}
+
+size_t RelationIndex::Release(const entt::entity entity)
+{
+    size_t released = 0;
+
+    // The lists are moved out first, erasing from the other side may not touch them
+    if (_targets.contains(entity))
+    {
+        const Edges targets = std::move(_targets.get(entity));
+        _targets.erase(entity);
+        for (const entt::entity target : targets) TryErase(_sources, target, entity);
+        released += targets.size();
+    }
+    if (_sources.contains(entity))
+    {
+        const Edges sources = std::move(_sources.get(entity));
+        _sources.erase(entity);
+        for (const entt::entity source : sources) TryErase(_targets, source, entity);
+        released += sources.size();
+    }
+
+    _edgeCount -= released;
+    return released;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+bool RelationIndex::TryErase(entt::storage<Edges>& lists, const entt::entity owner, const entt::entity entity)
+{
+    if (!lists.contains(owner)) return false;
+
+    Edges& edges = lists.get(owner);
+    auto it = std::find(edges.begin(), edges.end(), entity);
+    if (it == edges.end()) return false;
+
+    // Order carries no meaning, so swap with the last edge instead of shifting
+    *it = edges.back();
+    edges.pop_back();
+    if (edges.empty()) lists.erase(owner);
+    return true;
+}
+
+const RelationIndex::Edges& RelationIndex::GetEmpty()
+{
+    static const Edges empty;
+    return empty;
+}
+
+} // namespace velecs::ecs
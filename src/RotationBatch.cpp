@@ -0,0 +1,337 @@
+#include "velecs/ecs/RotationBatch.hpp"
+
+#include "velecs/ecs/Simd.hpp"
+#include "velecs/ecs/components/Transform.hpp"
+
+#include <cassert>
+#include <cmath>
+
+using namespace velecs::math;
+
+namespace velecs::ecs {
+
+// Public Fields
+
+const float RotationBatch::DEFAULT_TOLERANCE = 1e-4f;
+const float RotationBatch::SLERP_THRESHOLD = 1.0f - 1e-6f;
+
+// Constructors and Destructors
+
+// Public Methods
+
+void RotationBatch::Add(Transform* const transform)
+{
+    Push(transform, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void RotationBatch::Add(Transform* const transform, const Vec3& angularVelocity)
+{
+    Push(transform, angularVelocity.x, angularVelocity.y, angularVelocity.z, 0.0f);
+}
+
+void RotationBatch::Add(Transform* const transform, const Quat& target)
+{
+    Push(transform, target.x, target.y, target.z, target.w);
+}
+
+void RotationBatch::Normalize(const float tolerance)
+{
+    const size_t lanes = Pad();
+#if VELECS_ECS_SSE
+    if (_simdEnabled)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 tol = _mm_set1_ps(tolerance);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        for (size_t i = 0; i < lanes; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(&_x[i]);
+            const __m128 y = _mm_loadu_ps(&_y[i]);
+            const __m128 z = _mm_loadu_ps(&_z[i]);
+            const __m128 w = _mm_loadu_ps(&_w[i]);
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                                               _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+            const __m128 drift = _mm_and_ps(_mm_sub_ps(lengthSq, one), absMask);
+            const __m128 drifted = _mm_and_ps(_mm_cmpgt_ps(drift, tol), _mm_cmpgt_ps(lengthSq, zero));
+            const int mask = _mm_movemask_ps(drifted);
+            if (mask == 0) continue;
+
+            // Full precision, the reciprocal square root estimate would drift on its own. Lanes
+            // within tolerance keep their exact value, zero-length lanes would turn into NaN.
+            const __m128 scale = _mm_or_ps(_mm_and_ps(drifted, _mm_div_ps(one, _mm_sqrt_ps(lengthSq))),
+                                           _mm_andnot_ps(drifted, one));
+            _mm_storeu_ps(&_x[i], _mm_mul_ps(x, scale));
+            _mm_storeu_ps(&_y[i], _mm_mul_ps(y, scale));
+            _mm_storeu_ps(&_z[i], _mm_mul_ps(z, scale));
+            _mm_storeu_ps(&_w[i], _mm_mul_ps(w, scale));
+            for (size_t lane = 0; lane < 4; ++lane) _changed[i + lane] |= (mask >> lane) & 1;
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        const float lengthSq = _x[i] * _x[i] + _y[i] * _y[i] + _z[i] * _z[i] + _w[i] * _w[i];
+        if (lengthSq <= 0.0f || std::fabs(lengthSq - 1.0f) <= tolerance) continue;
+
+        const float scale = 1.0f / std::sqrt(lengthSq);
+        _x[i] *= scale;
+        _y[i] *= scale;
+        _z[i] *= scale;
+        _w[i] *= scale;
+        _changed[i] = 1;
+    }
+}
+
+void RotationBatch::Integrate(const float deltaTime)
+{
+    const size_t lanes = Pad();
+    const float halfStep = 0.5f * deltaTime;
+#if VELECS_ECS_SSE
+    if (_simdEnabled)
+    {
+        const __m128 h = _mm_set1_ps(halfStep);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        for (size_t i = 0; i < lanes; i += 4)
+        {
+            const __m128 ax = _mm_loadu_ps(&_operandX[i]);
+            const __m128 ay = _mm_loadu_ps(&_operandY[i]);
+            const __m128 az = _mm_loadu_ps(&_operandZ[i]);
+            const __m128 spinning = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(ax, zero), _mm_cmpneq_ps(ay, zero)), _mm_cmpneq_ps(az, zero));
+            const int mask = _mm_movemask_ps(spinning);
+            if (mask == 0) continue;
+
+            const __m128 x = _mm_loadu_ps(&_x[i]);
+            const __m128 y = _mm_loadu_ps(&_y[i]);
+            const __m128 z = _mm_loadu_ps(&_z[i]);
+            const __m128 w = _mm_loadu_ps(&_w[i]);
+
+            // q += h * (omega * q), with omega the pure quaternion (ax, ay, az, 0)
+            const __m128 dx = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(ax, w), _mm_mul_ps(ay, z)), _mm_mul_ps(az, y));
+            const __m128 dy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ay, w), _mm_mul_ps(ax, z)), _mm_mul_ps(az, x));
+            const __m128 dz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ax, y), _mm_mul_ps(ay, x)), _mm_mul_ps(az, w));
+            const __m128 dw = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, x), _mm_mul_ps(ay, y)), _mm_mul_ps(az, z)));
+
+            const __m128 nx = _mm_add_ps(x, _mm_mul_ps(h, dx));
+            const __m128 ny = _mm_add_ps(y, _mm_mul_ps(h, dy));
+            const __m128 nz = _mm_add_ps(z, _mm_mul_ps(h, dz));
+            const __m128 nw = _mm_add_ps(w, _mm_mul_ps(h, dw));
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                                               _mm_add_ps(_mm_mul_ps(nz, nz), _mm_mul_ps(nw, nw)));
+            const __m128 scale = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+
+            // Lanes without angular velocity keep their rotation untouched
+            const auto select = [spinning](const __m128 changed, const __m128 kept) {
+                return _mm_or_ps(_mm_and_ps(spinning, changed), _mm_andnot_ps(spinning, kept));
+            };
+            _mm_storeu_ps(&_x[i], select(_mm_mul_ps(nx, scale), x));
+            _mm_storeu_ps(&_y[i], select(_mm_mul_ps(ny, scale), y));
+            _mm_storeu_ps(&_z[i], select(_mm_mul_ps(nz, scale), z));
+            _mm_storeu_ps(&_w[i], select(_mm_mul_ps(nw, scale), w));
+            for (size_t lane = 0; lane < 4; ++lane) _changed[i + lane] |= (mask >> lane) & 1;
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        const float ax = _operandX[i], ay = _operandY[i], az = _operandZ[i];
+        if (ax == 0.0f && ay == 0.0f && az == 0.0f) continue;
+
+        const float x = _x[i], y = _y[i], z = _z[i], w = _w[i];
+        const float nx = x + halfStep * (ax * w + ay * z - az * y);
+        const float ny = y + halfStep * (ay * w - ax * z + az * x);
+        const float nz = z + halfStep * (ax * y - ay * x + az * w);
+        const float nw = w - halfStep * (ax * x + ay * y + az * z);
+        const float scale = 1.0f / std::sqrt(nx * nx + ny * ny + nz * nz + nw * nw);
+        _x[i] = nx * scale;
+        _y[i] = ny * scale;
+        _z[i] = nz * scale;
+        _w[i] = nw * scale;
+        _changed[i] = 1;
+    }
+}
+
+void RotationBatch::Slerp(const float t)
+{
+    // Nothing moves, so nothing may be reported as changed
+    if (t <= 0.0f) return;
+
+    const size_t lanes = Pad();
+    for (size_t i = 0; i < lanes; i += 4)
+    {
+        // The interpolation weights need acos and sin, which have no SSE instruction
+        float fromWeights[4];
+        float toWeights[4];
+        bool any = false;
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const size_t j = i + lane;
+            float dot = _x[j] * _operandX[j] + _y[j] * _operandY[j] + _z[j] * _operandZ[j] + _w[j] * _operandW[j];
+
+            // Take the shortest arc, q and -q are the same rotation
+            const float sign = dot < 0.0f ? -1.0f : 1.0f;
+            dot *= sign;
+
+            if (dot >= SLERP_THRESHOLD || j >= _transforms.size())
+            {
+                fromWeights[lane] = 1.0f;
+                toWeights[lane] = 0.0f;
+                continue;
+            }
+
+            if (dot > 0.9995f)
+            {
+                fromWeights[lane] = 1.0f - t;
+                toWeights[lane] = t * sign;
+            }
+            else
+            {
+                const float angle = std::acos(dot);
+                const float invSin = 1.0f / std::sin(angle);
+                fromWeights[lane] = std::sin((1.0f - t) * angle) * invSin;
+                toWeights[lane] = std::sin(t * angle) * invSin * sign;
+            }
+            any = true;
+        }
+        if (!any) continue;
+
+#if VELECS_ECS_SSE
+        if (_simdEnabled)
+        {
+            const __m128 x = _mm_loadu_ps(&_x[i]);
+            const __m128 y = _mm_loadu_ps(&_y[i]);
+            const __m128 z = _mm_loadu_ps(&_z[i]);
+            const __m128 w = _mm_loadu_ps(&_w[i]);
+            const __m128 from = _mm_loadu_ps(fromWeights);
+            const __m128 to = _mm_loadu_ps(toWeights);
+            const __m128 nx = _mm_add_ps(_mm_mul_ps(from, x), _mm_mul_ps(to, _mm_loadu_ps(&_operandX[i])));
+            const __m128 ny = _mm_add_ps(_mm_mul_ps(from, y), _mm_mul_ps(to, _mm_loadu_ps(&_operandY[i])));
+            const __m128 nz = _mm_add_ps(_mm_mul_ps(from, z), _mm_mul_ps(to, _mm_loadu_ps(&_operandZ[i])));
+            const __m128 nw = _mm_add_ps(_mm_mul_ps(from, w), _mm_mul_ps(to, _mm_loadu_ps(&_operandW[i])));
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                                               _mm_add_ps(_mm_mul_ps(nz, nz), _mm_mul_ps(nw, nw)));
+            const __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+            const __m128 rx = _mm_mul_ps(nx, scale);
+            const __m128 ry = _mm_mul_ps(ny, scale);
+            const __m128 rz = _mm_mul_ps(nz, scale);
+            const __m128 rw = _mm_mul_ps(nw, scale);
+
+            // Skipped lanes keep their exact value, and a tiny step may round back onto it
+            const __m128 moving = _mm_cmpneq_ps(to, _mm_setzero_ps());
+            const __m128 differs = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(rx, x), _mm_cmpneq_ps(ry, y)),
+                                             _mm_or_ps(_mm_cmpneq_ps(rz, z), _mm_cmpneq_ps(rw, w)));
+            const __m128 changed = _mm_and_ps(moving, differs);
+            const int mask = _mm_movemask_ps(changed);
+            if (mask == 0) continue;
+
+            const auto select = [changed](const __m128 result, const __m128 kept) {
+                return _mm_or_ps(_mm_and_ps(changed, result), _mm_andnot_ps(changed, kept));
+            };
+            _mm_storeu_ps(&_x[i], select(rx, x));
+            _mm_storeu_ps(&_y[i], select(ry, y));
+            _mm_storeu_ps(&_z[i], select(rz, z));
+            _mm_storeu_ps(&_w[i], select(rw, w));
+            for (size_t lane = 0; lane < 4; ++lane) _changed[i + lane] |= (mask >> lane) & 1;
+            continue;
+        }
+#endif
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            const size_t j = i + lane;
+            if (toWeights[lane] == 0.0f) continue;
+
+            const float nx = fromWeights[lane] * _x[j] + toWeights[lane] * _operandX[j];
+            const float ny = fromWeights[lane] * _y[j] + toWeights[lane] * _operandY[j];
+            const float nz = fromWeights[lane] * _z[j] + toWeights[lane] * _operandZ[j];
+            const float nw = fromWeights[lane] * _w[j] + toWeights[lane] * _operandW[j];
+            const float scale = 1.0f / std::sqrt(nx * nx + ny * ny + nz * nz + nw * nw);
+            const float rx = nx * scale, ry = ny * scale, rz = nz * scale, rw = nw * scale;
+            if (rx == _x[j] && ry == _y[j] && rz == _z[j] && rw == _w[j]) continue;
+
+            _x[j] = rx;
+            _y[j] = ry;
+            _z[j] = rz;
+            _w[j] = rw;
+            _changed[j] = 1;
+        }
+    }
+}
+
+size_t RotationBatch::Apply()
+{
+    size_t written = 0;
+    for (size_t i = 0; i < _transforms.size(); ++i)
+    {
+        if (!_changed[i]) continue;
+
+        Quat rot = _transforms[i]->GetRot();
+        rot.x = _x[i];
+        rot.y = _y[i];
+        rot.z = _z[i];
+        rot.w = _w[i];
+        _transforms[i]->SetRot(rot);
+        ++written;
+    }
+    Clear();
+    return written;
+}
+
+void RotationBatch::Clear()
+{
+    _transforms.clear();
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _w.clear();
+    _operandX.clear();
+    _operandY.clear();
+    _operandZ.clear();
+    _operandW.clear();
+    _changed.clear();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void RotationBatch::Push(Transform* const transform, const float x, const float y, const float z, const float w)
+{
+    assert(transform && "Rotation batches only take valid transforms");
+    assert(_x.size() == _transforms.size() && "Lanes cannot be added after a kernel ran, Apply() or Clear() first");
+
+    const Quat rot = transform->GetRot();
+    _transforms.push_back(transform);
+    _x.push_back(rot.x);
+    _y.push_back(rot.y);
+    _z.push_back(rot.z);
+    _w.push_back(rot.w);
+    _operandX.push_back(x);
+    _operandY.push_back(y);
+    _operandZ.push_back(z);
+    _operandW.push_back(w);
+    _changed.push_back(0);
+}
+
+size_t RotationBatch::Pad()
+{
+    const size_t lanes = (_transforms.size() + 3) & ~size_t{3};
+    _x.resize(lanes, 0.0f);
+    _y.resize(lanes, 0.0f);
+    _z.resize(lanes, 0.0f);
+    _w.resize(lanes, 1.0f);
+    _operandX.resize(lanes, 0.0f);
+    _operandY.resize(lanes, 0.0f);
+    _operandZ.resize(lanes, 0.0f);
+    _operandW.resize(lanes, 1.0f);
+    _changed.resize(lanes, 0);
+    return lanes;
+}
+
+} // namespace velecs::ecs
@@ -1,18 +1,46 @@
 #include "velecs/ecs/Component.hpp"
+#include "velecs/ecs/ComponentRegistry.hpp"
 #include "velecs/ecs/Entity.hpp"
 #include "velecs/ecs/EntityBuilder.hpp"
+#include "velecs/ecs/EntityReservation.hpp"
+#include "velecs/ecs/MetricsExporter.hpp"
 #include "velecs/ecs/Scene.hpp"
 #include "velecs/ecs/System.hpp"
 #include "velecs/ecs/World.hpp"
 
+#include "velecs/ecs/components/Transform.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
 namespace velecs::ecs {
 
+namespace {
+
+/// @brief Runs a system phase and measures how long it took.
+/// @return Elapsed time, or zero when statistics are compiled out.
+template<typename Func>
+std::chrono::nanoseconds TimePhase(Func&& phase)
+{
+#if VELECS_ECS_STATS_ENABLED
+    const auto start = std::chrono::steady_clock::now();
+    phase();
+    return std::chrono::steady_clock::now() - start;
+#else
+    phase();
+    return std::chrono::nanoseconds{0};
+#endif
+}
+
+} // namespace
+
 // Public Fields
 
 // Constructors and Destructors
 
 Scene::Scene(World* const world, const std::string& name, size_t systemCapacity)
-    : Object(world, name)
+    : Object(world, name), _commands(std::make_unique<MpscQueue<SceneCommand>>(COMMAND_QUEUE_CAPACITY))
 {
     _systemsIterator.reserve(systemCapacity);
     _systems.reserve(systemCapacity);
@@ -24,6 +52,7 @@ Scene::~Scene() = default;
 
 bool Scene::IsEntityHandleValid(const Entity* const entity)
 {
+    VELECS_ECS_COUNT(this, ValidityChecks);
     return entity != nullptr
         && entity->_scene == this
         && entity->GetWorld() == GetWorld()
@@ -40,15 +69,417 @@ EntityBuilder Scene::CreateEntity()
     return EntityBuilder(entity);
 }
 
+EntityReservation Scene::ReserveEntities(const size_t count, const size_t stagingCount)
+{
+    ComponentRegistry::Register<Transform>();
+    auto& transforms = GetRegistry().storage<Transform>();
+    transforms.reserve(transforms.size() + count);
+
+    std::vector<Entity*> entities = CreateEntities(count);
+    for (Entity* const entity : entities)
+    {
+        Transform& transform = transforms.emplace(entity->_handle);
+        transform._owner = entity;
+    }
+
+    return EntityReservation(this, std::move(entities), stagingCount);
+}
+
+size_t Scene::CommitReservation(EntityReservation& reservation)
+{
+    assert(reservation._scene == this && "Reservation belongs to a different scene");
+    if (reservation._committed) return 0;
+
+    size_t merged = 0;
+    for (SpawnStaging& staging : reservation._stagings)
+    {
+        for (const std::type_index& id : staging._order)
+        {
+            StagedPool& pool = *staging._pools.at(id);
+            merged += pool.GetCount();
+            pool.Commit(*this);
+        }
+        staging._order.clear();
+        staging._pools.clear();
+    }
+
+    reservation._committed = true;
+    return merged;
+}
+
+bool Scene::TryHibernate(Entity* const root)
+{
+    if (!IsEntityHandleValid(root)) return false;
+
+    entt::registry& registry = GetRegistry();
+    HibernatedSubtree subtree;
+
+    // Detach without touching the local transform, the link is restored on wake
+    Transform& rootTransform = root->GetTransform();
+    if (Entity* const parent = rootTransform._parent)
+    {
+        auto& siblings = parent->GetTransform()._children;
+        auto it = std::find(siblings.begin(), siblings.end(), root);
+        subtree.parent = parent->GetUuid();
+        subtree.siblingIndex = static_cast<size_t>(std::distance(siblings.begin(), it));
+        if (it != siblings.end()) siblings.erase(it);
+        rootTransform._parent = nullptr;
+    }
+
+    std::unordered_map<const Entity*, uint32_t> indices;
+    for (auto [entity, transform] : rootTransform.Traverse<TraversalOrder::PreOrder>())
+    {
+        indices.emplace(entity, static_cast<uint32_t>(subtree.entities.size()));
+        subtree.entities.push_back(entity);
+    }
+
+    BinaryWriter writer(subtree.data);
+    for (Entity* const entity : subtree.entities)
+    {
+        const Entity* const parent = entity->GetTransform()._parent;
+        const uint32_t parentIndex = parent ? indices.at(parent) : HibernatedSubtree::NO_PARENT;
+        writer.Write(parentIndex);
+        FreezeComponents(entity->_handle, writer, &subtree.boxes);
+    }
+
+    for (Entity* const entity : subtree.entities)
+    {
+        ReleaseRelations(entity->_handle);
+        registry.destroy(entity->_handle);
+        _entities.erase(entity->_handle);
+        *const_cast<entt::entity*>(&entity->_handle) = entt::null;
+    }
+
+    _hibernatedCount += subtree.entities.size();
+    _hibernated.insert_or_assign(root->GetUuid(), std::move(subtree));
+    return true;
+}
+
+bool Scene::TryWake(const Uuid& root, Entity*& outRoot)
+{
+    outRoot = nullptr;
+    auto it = _hibernated.find(root);
+    if (it == _hibernated.end()) return false;
+
+    // Nothing may be half-restored, so reject corrupt data before the first change
+    ValidateHibernated(it->second);
+
+    HibernatedSubtree subtree = std::move(it->second);
+    _hibernated.erase(it);
+    _hibernatedCount -= subtree.entities.size();
+
+    entt::registry& registry = GetRegistry();
+    std::vector<entt::entity> handles(subtree.entities.size());
+    registry.create(handles.begin(), handles.end());
+
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        Entity* const entity = subtree.entities[i];
+        *const_cast<entt::entity*>(&entity->_handle) = handles[i];
+        _entities.try_emplace(handles[i], entity->GetUuid());
+    }
+
+    // Pre-order puts every parent before its children, so appending keeps sibling order
+    BinaryReader reader(subtree.data);
+    for (Entity* const entity : subtree.entities)
+    {
+        const uint32_t parentIndex = reader.Read<uint32_t>();
+        ThawComponents(entity, reader, &subtree.boxes);
+        if (parentIndex == HibernatedSubtree::NO_PARENT) continue;
+
+        Transform* transform{nullptr};
+        const bool hasTransform = TryGetComponent<Transform>(entity, transform);
+        assert(hasTransform && "Validated subtrees always restore a Transform");
+        (void)hasTransform;
+
+        Entity* const parent = subtree.entities[parentIndex];
+        transform->_parent = parent;
+        parent->GetTransform()._children.push_back(entity);
+    }
+
+    outRoot = subtree.entities.front();
+
+    VELECS_ECS_COUNT(this, WorldLookups);
+    Entity* const parent = GetWorld()->TryGet<Entity>(subtree.parent);
+    if (parent && parent->GetScene() == this && parent->IsValid())
+    {
+        auto& siblings = parent->GetTransform()._children;
+        const size_t index = std::min(subtree.siblingIndex, siblings.size());
+        siblings.insert(siblings.begin() + index, outRoot);
+        outRoot->GetTransform()._parent = parent;
+    }
+    outRoot->GetTransform().SetDirty();
+    return true;
+}
+
+CompactionReport Scene::Compact()
+{
+    CompactionReport report;
+    entt::registry& registry = GetRegistry();
+
+    // Destroyed entities keep their map entry and Entity object until now
+    std::vector<Uuid> released;
+    released.reserve(_staleEntityCount);
+    for (auto it = _entities.begin(); it != _entities.end();)
+    {
+        if (registry.valid(it->first))
+        {
+            ++it;
+            continue;
+        }
+        released.push_back(it->second);
+        it = _entities.erase(it);
+    }
+    _staleEntityCount = 0;
+    report.entitiesReleased = GetWorld()->RemoveBatch<Entity>(released);
+    report.bytesReclaimed += report.entitiesReleased * (sizeof(Entity) + sizeof(std::pair<const entt::entity, Uuid>));
+
+    const size_t buckets = _entities.bucket_count();
+    _entities.rehash(0);
+    if (_entities.bucket_count() < buckets) report.bytesReclaimed += (buckets - _entities.bucket_count()) * sizeof(void*);
+
+    for (auto [id, pool] : registry.storage())
+    {
+        const ComponentOps* ops{nullptr};
+        const size_t valueSize = ComponentRegistry::TryGet(id, ops) ? ops->valueSize : 0;
+
+        const size_t size = pool.size();
+        const size_t capacity = pool.capacity();
+        pool.compact();
+
+        // Declared pools keep the capacity they were warmed to, only growth beyond it is released
+        const size_t declared = GetDeclaredCapacity(id);
+        if (capacity > declared)
+        {
+            pool.shrink_to_fit();
+            if (pool.capacity() < declared) pool.reserve(declared);
+        }
+        if (pool.size() == size && pool.capacity() == capacity) continue;
+
+        ++report.poolsCompacted;
+        report.tombstonesRemoved += size - pool.size();
+        report.bytesReclaimed += (capacity - pool.capacity()) * (sizeof(entt::entity) + valueSize);
+    }
+
+    report.bytesReclaimed += GetWorld()->Compact();
+    return report;
+}
+
+bool Scene::TryEnqueueSpawn(std::function<void(Entity* const)> init)
+{
+    SceneCommand command;
+    command.type = SceneCommand::Type::Spawn;
+    command.callback = std::move(init);
+    return _commands->TryPush(std::move(command));
+}
+
+bool Scene::TryEnqueueDestroy(const Uuid& uuid)
+{
+    SceneCommand command;
+    command.type = SceneCommand::Type::Destroy;
+    command.target = uuid;
+    return _commands->TryPush(std::move(command));
+}
+
+bool Scene::TryEnqueueUpdate(const Uuid& uuid, std::function<void(Entity* const)> update)
+{
+    SceneCommand command;
+    command.type = SceneCommand::Type::Update;
+    command.target = uuid;
+    command.callback = std::move(update);
+    return _commands->TryPush(std::move(command));
+}
+
+bool Scene::TryDestroyCachedQuery(const CachedQueryBase* const query)
+{
+    auto it = std::find_if(_cachedQueries.begin(), _cachedQueries.end(),
+        [query](const std::unique_ptr<CachedQueryBase>& owned) { return owned.get() == query; });
+    if (it == _cachedQueries.end()) return false;
+
+    _cachedQueries.erase(it);
+    return true;
+}
+
+size_t Scene::PropagateTransforms()
+{
+    const auto& transforms = GetRegistry().storage<Transform>();
+    const entt::sparse_set& handles = transforms;
+    if (handles.empty()) return 0;
+
+    struct WorkItem {
+        const Transform* top; ///< @brief Dirty transform whose parent is clean or missing.
+        size_t size;          ///< @brief Number of transforms in its subtree.
+    };
+
+    WorkerPool& workers = *GetWorld()->workers;
+    const size_t threadCount = workers.GetThreadCount();
+
+    // Find and size the dirty subtrees, nothing is written yet so every read is safe
+    const size_t chunkSize = GetChunkSize(handles.size(), threadCount);
+    const size_t chunkCount = (handles.size() + chunkSize - 1) / chunkSize;
+    std::vector<std::vector<WorkItem>> found(chunkCount);
+    workers.ParallelFor(chunkCount, [&transforms, &handles, &found, chunkSize](const size_t chunk) {
+        const size_t end = std::min(handles.size(), (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; ++i)
+        {
+            const Transform& transform = transforms.get(handles.data()[i]);
+            if (!transform.isWorldDirty) continue;
+
+            // Dirtiness always reaches the whole subtree, so a dirty parent already covers this one
+            if (transform._parent && transform._parent->GetTransform().isWorldDirty) continue;
+
+            found[chunk].push_back(WorkItem{&transform, transform.GetSubtreeSize()});
+        }
+    });
+
+    std::vector<WorkItem> items;
+    for (std::vector<WorkItem>& chunkItems : found)
+    {
+        items.insert(items.end(), chunkItems.begin(), chunkItems.end());
+    }
+    if (items.empty()) return 0;
+
+    // Longest processing time first, each subtree goes to the least loaded bin
+    std::sort(items.begin(), items.end(), [](const WorkItem& lhs, const WorkItem& rhs) {
+        return lhs.size > rhs.size;
+    });
+    const size_t binCount = std::min(threadCount, items.size());
+    std::vector<std::vector<const Transform*>> bins(binCount);
+    std::vector<size_t> loads(binCount, 0);
+    for (const WorkItem& item : items)
+    {
+        const size_t bin = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        bins[bin].push_back(item.top);
+        loads[bin] += item.size;
+    }
+
+    // Subtrees are disjoint and their parents are clean, so workers never write the same node
+    workers.ParallelFor(binCount, [this, &bins, &loads](const size_t bin) {
+        size_t modelRecomputes = 0;
+        for (const Transform* top : bins[bin])
+        {
+            const Affine3x4& parentWorld = top->_parent
+                ? top->_parent->GetTransform().cachedWorldMat
+                : Affine3x4::IDENTITY;
+            modelRecomputes += top->PropagateWorld(parentWorld);
+        }
+        VELECS_ECS_COUNT_N(this, ModelRecomputes, modelRecomputes);
+        VELECS_ECS_COUNT_N(this, WorldRecomputes, loads[bin]);
+    });
+
+    size_t propagated = 0;
+    for (const size_t load : loads) propagated += load;
+    return propagated;
+}
+
+void Scene::ApplyCommands(CommandBuffer& buffer)
+{
+    for (SceneCommand& command : buffer._commands) ExecuteCommand(command);
+    buffer._commands.clear();
+}
+
+SceneStats Scene::GetStats() const
+{
+    auto load = [this](const SceneCounter counter) {
+        return _counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    };
+
+    SceneStats stats;
+    stats.entityLookups = load(SceneCounter::EntityLookups);
+    stats.worldLookups = load(SceneCounter::WorldLookups);
+    stats.validityChecks = load(SceneCounter::ValidityChecks);
+    stats.modelRecomputes = load(SceneCounter::ModelRecomputes);
+    stats.worldRecomputes = load(SceneCounter::WorldRecomputes);
+    stats.dirtyVisits = load(SceneCounter::DirtyVisits);
+    return stats;
+}
+
+void Scene::ResetStats()
+{
+    for (auto& counter : _counters)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Scene::CollectMetrics(MetricsSnapshot& snapshot) const
+{
+    MetricsSnapshot::SceneMetrics metrics;
+    metrics.name = GetName();
+    metrics.entityCount = GetEntityCount();
+    metrics.lastCleanupCount = _lastCleanupCount;
+    metrics.totalCleanupCount = _totalCleanupCount;
+    metrics.frameStats = _frameStats;
+
+    if (_registry.has_value())
+    {
+        for (auto [id, storage] : _registry->storage())
+        {
+            metrics.pools.push_back({std::string(storage.type().name()), storage.size(), storage.capacity()});
+        }
+    }
+
+    for (auto id : _systemsIterator)
+    {
+        const System* system = _systems.at(id).get();
+        metrics.systems.push_back({id.name(), system->GetTimings()});
+    }
+
+    snapshot.scenes.push_back(std::move(metrics));
+}
+
+StateHash Scene::ComputeStateHash() const
+{
+    StateHash result;
+    for (auto [id, pool] : GetRegistry().storage())
+    {
+        // Pools are created lazily, an empty pool is not part of the state
+        if (pool.empty()) continue;
+
+        StateHash::PoolHash poolHash;
+        poolHash.id = id;
+        poolHash.name = std::string(pool.type().name());
+        poolHash.size = pool.size();
+
+        StateHasher hasher;
+        hasher.Update(pool.data(), pool.size() * sizeof(entt::entity));
+
+        const ComponentOps* ops{nullptr};
+        if (ComponentRegistry::TryGet(id, ops) && ops->hashState)
+        {
+            ops->hashState(pool, hasher);
+            poolHash.hasValues = true;
+        }
+
+        poolHash.hash = hasher.Finalize();
+        result.pools.push_back(std::move(poolHash));
+    }
+
+    // Pool creation order depends on history, sort so equal states compare equal
+    std::sort(result.pools.begin(), result.pools.end(),
+        [](const StateHash::PoolHash& a, const StateHash::PoolHash& b) { return a.id < b.id; });
+
+    StateHasher combined;
+    for (const auto& poolHash : result.pools)
+    {
+        combined.Update(poolHash.id);
+        combined.Update(poolHash.hash);
+    }
+    result.combined = combined.Finalize();
+    return result;
+}
+
 // Protected Fields
 
 // Protected Methods
 
 Entity* Scene::TryGetEntity(const entt::entity handle)
 {
+    VELECS_ECS_COUNT(this, EntityLookups);
     auto it = _entities.find(handle);
     if (it == _entities.end()) return nullptr;
     auto uuid = it->second;
+    VELECS_ECS_COUNT(this, WorldLookups);
     return GetWorld()->TryGet<Entity>(uuid);
 }
 
@@ -73,23 +504,288 @@ void Scene::Init(void* context)
     // Instantiates the scene's EnTT registry
     _registry.emplace();
     std::cout << "Registry emplaced for: " << GetName() << std::endl;
+
+    // Pay for pool construction now rather than on first use mid-frame
+    for (const PoolDeclaration& declaration : _declaredPools)
+    {
+        declaration.warm(*_registry, declaration.capacity);
+    }
+
     OnEnter(context);
 }
 
-void Scene::Cleanup(void* context)
+void Scene::Cleanup(void* context, SceneReleaser* const releaser)
 {
+    // Commands queued for this activation must not leak into the next one
+    SceneCommand discarded;
+    while (_commands->TryPop(discarded)) {}
+
     if (_registry.has_value())
     {
         OnExit(context);
-        // Released the scene's EnTT registry
-        _registry->clear();
-        _registry.reset();
+
+        DetachedScene detached = Detach();
+        if (releaser) releaser->Submit(std::move(detached));
+
+        // Otherwise the detached state is destroyed here. Dropping the registry without clearing
+        // it skips the per-entity erasure and destroy signals, every destructor still runs.
+    }
+}
+
+void Scene::ReleaseRelations(const entt::entity handle)
+{
+    for (auto& [kind, index] : _relations) index.Release(handle);
+}
+
+void Scene::SwapEventChannels()
+{
+    for (auto& [type, slot] : _eventChannels) slot.swap(slot.channel.get());
+}
+
+size_t Scene::ProcessCommands()
+{
+    const size_t limit = _commands->GetCapacity();
+
+    size_t count = 0;
+    SceneCommand command;
+    while (count < limit && _commands->TryPop(command))
+    {
+        ExecuteCommand(command);
+        ++count;
+    }
+    return count;
+}
+
+std::vector<Entity*> Scene::CreateEntities(const size_t count)
+{
+    std::vector<entt::entity> handles(count);
+    GetRegistry().create(handles.begin(), handles.end());
+
+    _entities.reserve(_entities.size() + count);
+    GetWorld()->Reserve<Entity>(count);
+
+    std::vector<Entity*> entities;
+    entities.reserve(count);
+    for (const entt::entity handle : handles)
+    {
+        Entity* const entity = Object::Create<Entity>(GetWorld(), this, handle);
+        auto [it, inserted] = _entities.try_emplace(handle, entity->GetUuid());
+        assert(inserted && "A new entity should never fail to be inserted");
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+size_t Scene::DestroyEntities(const std::vector<Entity*>& entities)
+{
+    std::vector<entt::entity> handles;
+    std::vector<Uuid> uuids;
+    handles.reserve(entities.size());
+    uuids.reserve(entities.size());
+    for (Entity* const entity : entities)
+    {
+        // Hibernated entities are invalid too, and their objects must survive until they wake
+        if (!entity->IsValid()) continue;
+        ReleaseRelations(entity->_handle);
+        handles.push_back(entity->_handle);
+        uuids.push_back(entity->GetUuid());
+        _entities.erase(entity->_handle);
+    }
+    GetRegistry().destroy(handles.begin(), handles.end());
+    GetWorld()->RemoveBatch<Entity>(uuids);
+
+    return handles.size();
+}
+
+DetachedScene Scene::Detach()
+{
+    // Cached queries are connected to the registry's signals, so they go first
+    _cachedQueries.clear();
+
+    // Types that must be destroyed on the frame thread never leave it, nor do types whose traits are unknown
+    for (auto [id, pool] : _registry->storage())
+    {
+        const ComponentOps* ops{nullptr};
+        if (!ComponentRegistry::TryGet(id, ops) || ops->mainThreadDestruction) pool.clear();
+    }
+
+    DetachedScene detached;
+    detached.registry = std::move(_registry);
+    _registry.reset();
+
+    // Entries of destroyed entities linger in _entities, so this also releases their objects
+    std::vector<Uuid> uuids;
+    uuids.reserve(_entities.size() + _hibernatedCount);
+    for (const auto& [handle, uuid] : _entities) uuids.push_back(uuid);
+    for (const auto& [root, subtree] : _hibernated)
+    {
+        for (const Entity* const entity : subtree.entities) uuids.push_back(entity->GetUuid());
+    }
+
+    _entities.clear();
+    _staleEntityCount = 0;
+    _hibernated.clear();
+    _hibernatedCount = 0;
+    _relations.clear();
+    _eventChannels.clear();
+
+    GetWorld()->RemoveBatch<Entity>(uuids, &detached.entities);
+    return detached;
+}
+
+bool Scene::IsCompactionDue() const
+{
+    const auto underused = [this](const size_t used, const size_t capacity) {
+        return capacity >= _compactionPolicy.minCapacity
+            && static_cast<float>(used) < _compactionPolicy.minOccupancy * static_cast<float>(capacity);
+    };
+
+    if (underused(_entities.size() - std::min(_staleEntityCount, _entities.size()), _entities.size())) return true;
+    for (auto [id, pool] : GetRegistry().storage())
+    {
+        // Compaction keeps a declared pool's capacity, so only growth beyond it is worth reclaiming
+        const size_t declared = GetDeclaredCapacity(id);
+        if (pool.capacity() > declared && underused(std::max(pool.size(), declared), pool.capacity())) return true;
+    }
+    return false;
+}
+
+size_t Scene::GetDeclaredCapacity(const entt::id_type id) const
+{
+    auto it = std::find_if(_declaredPools.begin(), _declaredPools.end(),
+        [id](const PoolDeclaration& declaration) { return declaration.id == id; });
+    return it == _declaredPools.end() ? 0 : it->capacity;
+}
+
+uint32_t Scene::FreezeComponents(const entt::entity handle, BinaryWriter& writer, ColdBoxes* const boxes)
+{
+    const size_t countOffset = writer.GetSize();
+    writer.Write(uint32_t{0});
+
+    uint32_t count = 0;
+    for (auto [id, pool] : GetRegistry().storage())
+    {
+        if (!pool.contains(handle)) continue;
+
+        const ComponentOps* ops{nullptr};
+        if (!ComponentRegistry::TryGet(id, ops))
+        {
+            std::cerr << "[WARNING] Dropping unregistered component '" << pool.type().name() << "' while freezing an entity." << std::endl;
+            continue;
+        }
+
+        const size_t start = writer.GetSize();
+        writer.Write(id);
+        writer.Write(uint32_t{0});
+        if (!ops->freeze(pool, handle, writer, boxes))
+        {
+            writer.Truncate(start);
+            std::cerr << "[WARNING] Dropping component '" << ops->name << "' while freezing an entity, it has no codec and cannot be moved." << std::endl;
+            continue;
+        }
+
+        const size_t payloadStart = start + sizeof(id) + sizeof(uint32_t);
+        writer.Patch(start + sizeof(id), static_cast<uint32_t>(writer.GetSize() - payloadStart));
+        ++count;
+    }
+
+    writer.Patch(countOffset, count);
+    return count;
+}
+
+void Scene::ValidateHibernated(const HibernatedSubtree& subtree) const
+{
+    const entt::id_type transformId = entt::type_hash<Transform>::value();
+
+    BinaryReader reader(subtree.data);
+    for (size_t i = 0; i < subtree.entities.size(); ++i)
+    {
+        // Pre-order puts every parent before its children
+        const uint32_t parentIndex = reader.Read<uint32_t>();
+        if (parentIndex != HibernatedSubtree::NO_PARENT && parentIndex >= i)
+        {
+            throw std::runtime_error("Hibernated entity references a parent that does not precede it");
+        }
+
+        bool hasTransform = false;
+        const uint32_t count = reader.Read<uint32_t>();
+        for (uint32_t c = 0; c < count; ++c)
+        {
+            const entt::id_type id = reader.Read<entt::id_type>();
+            hasTransform |= (id == transformId);
+            reader.Skip(reader.Read<uint32_t>());
+        }
+        if (!hasTransform) throw std::runtime_error("Hibernated entity is missing its Transform");
+    }
+}
+
+void Scene::ThawComponents(Entity* const entity, BinaryReader& reader, ColdBoxes* const boxes)
+{
+    entt::registry& registry = GetRegistry();
+
+    const uint32_t count = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const entt::id_type id = reader.Read<entt::id_type>();
+        const uint32_t size = reader.Read<uint32_t>();
+
+        const ComponentOps* ops{nullptr};
+        if (!ComponentRegistry::TryGet(id, ops))
+        {
+            // Data written by another process may name types this one never created
+            std::cerr << "[WARNING] Skipping unregistered component type " << id << " while thawing an entity." << std::endl;
+            reader.Skip(size);
+            continue;
+        }
+
+        const size_t end = reader.GetPosition() + size;
+        Component* const comp = ops->thaw(registry, entity->_handle, reader, boxes);
+        if (comp) comp->_owner = entity;
+
+        if (reader.GetPosition() != end)
+        {
+            throw std::runtime_error("Component '" + ops->name + "' read a different amount of data than it wrote");
+        }
+    }
+}
+
+size_t Scene::GetChunkSize(const size_t rowCount, const size_t threadCount) const
+{
+    if (_deterministic) return _parallelChunkSize;
+
+    // Fewer, larger chunks when chunk indices do not need to be reproducible
+    const size_t perThread = (rowCount + threadCount - 1) / threadCount;
+    return std::max(_parallelChunkSize, perThread);
+}
+
+void Scene::ExecuteCommand(SceneCommand& command)
+{
+    switch (command.type)
+    {
+        case SceneCommand::Type::Spawn:
+        {
+            Entity* entity = CreateEntity();
+            if (command.callback) command.callback(entity);
+            break;
+        }
+        case SceneCommand::Type::Destroy:
+        case SceneCommand::Type::Update:
+        {
+            VELECS_ECS_COUNT(this, WorldLookups);
+            Entity* entity = GetWorld()->TryGet<Entity>(command.target);
+            if (!entity || entity->GetScene() != this || !entity->IsValid()) break;
+
+            if (command.type == SceneCommand::Type::Destroy) entity->MarkForDestruction();
+            else if (command.callback) command.callback(entity);
+            break;
+        }
     }
 }
 
 void Scene::DestroyEntity(Entity* const entity)
 {
     if (!entity || !entity->IsValid()) return;
+    ReleaseRelations(entity->_handle);
     GetRegistry().destroy(entity->_handle);
 }
 
@@ -99,7 +795,7 @@ void Scene::Process(void* context)
     {
         System* system = _systems[id].get();
         if (!system->IsEnabled()) continue;
-        system->Process(context);
+        system->_timings.process = TimePhase([&]() { system->Process(context); });
     }
 }
 
@@ -109,7 +805,7 @@ void Scene::ProcessPhysics(void* context)
     {
         System* system = _systems[id].get();
         if (!system->IsEnabled()) continue;
-        system->ProcessPhysics(context);
+        system->_timings.processPhysics = TimePhase([&]() { system->ProcessPhysics(context); });
     }
 }
 
@@ -119,7 +815,7 @@ void Scene::ProcessGUI(void* context)
     {
         System* system = _systems[id].get();
         if (!system->IsEnabled()) continue;
-        system->ProcessGUI(context);
+        system->_timings.processGUI = TimePhase([&]() { system->ProcessGUI(context); });
     }
 }
 
@@ -134,6 +830,7 @@ void Scene::ProcessEntityCleanup()
     });
 
     
+    uint64_t destroyedCount = 0;
     for (Entity* entityToDelete : destructionQueue)
     {
         // May already have been deleted
@@ -145,8 +842,19 @@ void Scene::ProcessEntityCleanup()
             if (entity == entityToDelete) transform.TrySetParent(nullptr);
 
             DestroyEntity(entity);
+            ++destroyedCount;
         }
     }
+
+    _lastCleanupCount = destroyedCount;
+    _totalCleanupCount += destroyedCount;
+    _staleEntityCount += destroyedCount;
+
+    if (destroyedCount > 0 && _compactionPolicy.enabled && IsCompactionDue()) Compact();
+
+    // Cleanup is the last phase of a frame, so roll the counters over here
+    _frameStats = GetStats();
+    ResetStats();
 }
 
 } // namespace velecs::ecs
@@ -0,0 +1,398 @@
+#include "velecs/ecs/SceneJournal.hpp"
+
+#include "velecs/ecs/Entity.hpp"
+#include "velecs/ecs/Scene.hpp"
+#include "velecs/ecs/World.hpp"
+#include "velecs/ecs/components/Transform.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+namespace velecs::ecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+SceneJournal::SceneJournal(Scene* const scene, const size_t maxSteps)
+    : _scene(scene), _maxSteps(maxSteps)
+{
+    assert(_scene && "Journal requires a scene");
+    assert(_maxSteps > 0 && "Journal must keep at least one step");
+}
+
+// Public Methods
+
+EntityBuilder SceneJournal::CreateEntity()
+{
+    EntityBuilder builder = _scene->CreateEntity();
+    RecordLifetime(OpCode::Create, builder);
+    return builder;
+}
+
+bool SceneJournal::TryDestroy(Entity* const root)
+{
+    if (!_scene->TryHibernate(root)) return false;
+    RecordLifetime(OpCode::Destroy, root);
+    return true;
+}
+
+bool SceneJournal::TrySetParent(Entity* const entity, Entity* const newParent)
+{
+    if (!entity || !entity->IsValid()) return false;
+
+    Transform& transform = entity->GetTransform();
+    Entity* const oldParent = transform.GetParent();
+    if (oldParent == newParent) return false;
+
+    const size_t oldIndex = transform.GetSiblingIndex();
+    if (!transform.TrySetParent(newParent)) return false;
+
+    RecordReparent(entity, oldParent, oldIndex, newParent, transform.GetSiblingIndex());
+    return true;
+}
+
+bool SceneJournal::TrySetSiblingIndex(Entity* const entity, const size_t index)
+{
+    if (!entity || !entity->IsValid()) return false;
+
+    Transform& transform = entity->GetTransform();
+    Entity* const parent = transform.GetParent();
+    const size_t oldIndex = transform.GetSiblingIndex();
+    if (!transform.TrySetSiblingIndex(index)) return false;
+
+    const size_t newIndex = transform.GetSiblingIndex();
+    if (newIndex == oldIndex) return false;
+
+    RecordReparent(entity, parent, oldIndex, parent, newIndex);
+    return true;
+}
+
+void SceneJournal::BeginTransaction()
+{
+    if (_transactionDepth++ == 0)
+    {
+        _transactionHasStep = false;
+        _canCoalesce = false;
+    }
+}
+
+void SceneJournal::EndTransaction()
+{
+    assert(_transactionDepth > 0 && "EndTransaction() without a matching BeginTransaction()");
+    if (--_transactionDepth == 0) _canCoalesce = false;
+}
+
+bool SceneJournal::TryUndo()
+{
+    assert(_transactionDepth == 0 && "Cannot undo while a transaction is open");
+    if (_cursor == 0) return false;
+
+    const Step& step = _steps[--_cursor];
+    bool clean = true;
+    for (auto it = step.ops.rbegin(); it != step.ops.rend(); ++it)
+    {
+        clean = TryApply(step, *it, true) && clean;
+    }
+
+    if (!clean)
+    {
+        std::cerr << "[WARNING] Some journaled edits could not be undone, the scene was modified outside the journal." << std::endl;
+    }
+    _canCoalesce = false;
+    return true;
+}
+
+bool SceneJournal::TryRedo()
+{
+    assert(_transactionDepth == 0 && "Cannot redo while a transaction is open");
+    if (_cursor == _steps.size()) return false;
+
+    const Step& step = _steps[_cursor++];
+    bool clean = true;
+    for (const uint32_t offset : step.ops)
+    {
+        clean = TryApply(step, offset, false) && clean;
+    }
+
+    if (!clean)
+    {
+        std::cerr << "[WARNING] Some journaled edits could not be redone, the scene was modified outside the journal." << std::endl;
+    }
+    _canCoalesce = false;
+    return true;
+}
+
+size_t SceneJournal::GetByteSize() const
+{
+    size_t size = 0;
+    for (const Step& step : _steps)
+    {
+        size += step.data.size() + step.ops.size() * sizeof(uint32_t);
+    }
+    return size + _entityTable.size() * sizeof(Uuid);
+}
+
+void SceneJournal::Clear()
+{
+    _steps.clear();
+    _cursor = 0;
+    _entityTable.clear();
+    _entityIndices.clear();
+    _tableCompactionSize = MIN_TABLE_COMPACTION;
+    _transactionHasStep = false;
+    _canCoalesce = false;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+uint32_t SceneJournal::GetEntityIndex(Entity* const entity)
+{
+    auto [it, inserted] = _entityIndices.try_emplace(entity->GetUuid(), static_cast<uint32_t>(_entityTable.size()));
+    if (inserted) _entityTable.push_back(entity->GetUuid());
+    return it->second;
+}
+
+Entity* SceneJournal::TryResolve(const uint32_t entityIndex) const
+{
+    return _scene->GetWorld()->TryGet<Entity>(_entityTable.at(entityIndex));
+}
+
+void SceneJournal::TrimEntityTable()
+{
+    if (_entityTable.size() < _tableCompactionSize) return;
+
+    // Renumber the entries in the order the remaining steps use them, dropping the rest
+    std::vector<uint32_t> remap(_entityTable.size(), NO_ENTITY);
+    std::vector<Uuid> table;
+    auto renumber = [&](Step& step, const size_t position) {
+        BinaryReader reader(step.data.data() + position, step.data.size() - position);
+        const uint32_t entityIndex = reader.Read<uint32_t>();
+        if (entityIndex == NO_ENTITY) return;
+
+        if (remap[entityIndex] == NO_ENTITY)
+        {
+            remap[entityIndex] = static_cast<uint32_t>(table.size());
+            table.push_back(_entityTable[entityIndex]);
+        }
+        BinaryWriter writer(step.data);
+        writer.Patch(position, remap[entityIndex]);
+    };
+
+    for (Step& step : _steps)
+    {
+        for (const uint32_t offset : step.ops)
+        {
+            // Every operation starts with its entity, reparents also hold both parents
+            const size_t entityPosition = offset + sizeof(uint8_t);
+            renumber(step, entityPosition);
+            if (static_cast<OpCode>(step.data[offset]) == OpCode::Reparent)
+            {
+                renumber(step, entityPosition + sizeof(uint32_t));
+                renumber(step, entityPosition + 3 * sizeof(uint32_t));
+            }
+        }
+    }
+
+    _entityTable = std::move(table);
+    _entityIndices.clear();
+    for (uint32_t i = 0; i < _entityTable.size(); ++i) _entityIndices.emplace(_entityTable[i], i);
+
+    // Wait for the table to double again, so compaction stays amortized over the edits
+    _tableCompactionSize = std::max(MIN_TABLE_COMPACTION, 2 * _entityTable.size());
+}
+
+SceneJournal::Step& SceneJournal::GetRecordingStep()
+{
+    // A new edit makes the undone steps unreachable
+    if (_cursor < _steps.size()) _steps.resize(_cursor);
+
+    if (_transactionDepth == 0 || !_transactionHasStep)
+    {
+        _steps.emplace_back();
+        if (_steps.size() > _maxSteps) _steps.erase(_steps.begin());
+        _transactionHasStep = _transactionDepth > 0;
+    }
+
+    _cursor = _steps.size();
+    return _steps.back();
+}
+
+SceneJournal::Step* SceneJournal::TryGetCoalescable(const OpCode op, const uint32_t entityIndex, size_t& outOffset)
+{
+    if (!_canCoalesce || _cursor != _steps.size() || _steps.empty()) return nullptr;
+
+    Step& step = _steps.back();
+    if (step.ops.empty()) return nullptr;
+
+    outOffset = step.ops.back();
+    BinaryReader reader(step.data.data() + outOffset, step.data.size() - outOffset);
+    if (static_cast<OpCode>(reader.Read<uint8_t>()) != op) return nullptr;
+    if (reader.Read<uint32_t>() != entityIndex) return nullptr;
+    return &step;
+}
+
+void SceneJournal::RecordWrite(Entity* const entity, const entt::id_type id,
+    const std::vector<unsigned char>& before, const std::vector<unsigned char>& after)
+{
+    TrimEntityTable();
+    const uint32_t entityIndex = GetEntityIndex(entity);
+
+    size_t offset{0};
+    if (Step* const step = TryGetCoalescable(OpCode::Write, entityIndex, offset))
+    {
+        BinaryReader reader(step->data.data() + offset, step->data.size() - offset);
+        reader.Skip(sizeof(uint8_t) + sizeof(uint32_t));
+        if (reader.Read<entt::id_type>() == id)
+        {
+            // Keep the oldest before state and replace the after state, it is the last thing in the step
+            const uint32_t beforeSize = reader.Read<uint32_t>();
+            reader.Skip(beforeSize);
+
+            BinaryWriter writer(step->data);
+            writer.Truncate(offset + reader.GetPosition());
+            writer.Write(static_cast<uint32_t>(after.size()));
+            writer.Write(after.data(), after.size());
+            return;
+        }
+    }
+
+    // Nothing to undo
+    if (before == after) return;
+
+    Step& step = GetRecordingStep();
+    step.ops.push_back(static_cast<uint32_t>(step.data.size()));
+
+    BinaryWriter writer(step.data);
+    writer.Write(static_cast<uint8_t>(OpCode::Write));
+    writer.Write(entityIndex);
+    writer.Write(id);
+    writer.Write(static_cast<uint32_t>(before.size()));
+    writer.Write(before.data(), before.size());
+    writer.Write(static_cast<uint32_t>(after.size()));
+    writer.Write(after.data(), after.size());
+    _canCoalesce = true;
+}
+
+void SceneJournal::RecordReparent(Entity* const entity, Entity* const oldParent, const size_t oldIndex,
+    Entity* const newParent, const size_t newIndex)
+{
+    TrimEntityTable();
+    const uint32_t entityIndex = GetEntityIndex(entity);
+    const uint32_t newParentIndex = newParent ? GetEntityIndex(newParent) : NO_ENTITY;
+
+    size_t offset{0};
+    if (Step* const step = TryGetCoalescable(OpCode::Reparent, entityIndex, offset))
+    {
+        // Keep the original parent and index, only move the destination
+        const size_t destination = offset + sizeof(uint8_t) + 3 * sizeof(uint32_t);
+        BinaryWriter writer(step->data);
+        writer.Patch(destination, newParentIndex);
+        writer.Patch(destination + sizeof(uint32_t), static_cast<uint32_t>(newIndex));
+        return;
+    }
+
+    const uint32_t oldParentIndex = oldParent ? GetEntityIndex(oldParent) : NO_ENTITY;
+
+    Step& step = GetRecordingStep();
+    step.ops.push_back(static_cast<uint32_t>(step.data.size()));
+
+    BinaryWriter writer(step.data);
+    writer.Write(static_cast<uint8_t>(OpCode::Reparent));
+    writer.Write(entityIndex);
+    writer.Write(oldParentIndex);
+    writer.Write(static_cast<uint32_t>(oldIndex));
+    writer.Write(newParentIndex);
+    writer.Write(static_cast<uint32_t>(newIndex));
+    _canCoalesce = true;
+}
+
+void SceneJournal::RecordLifetime(const OpCode op, Entity* const entity)
+{
+    TrimEntityTable();
+    const uint32_t entityIndex = GetEntityIndex(entity);
+
+    Step& step = GetRecordingStep();
+    step.ops.push_back(static_cast<uint32_t>(step.data.size()));
+
+    BinaryWriter writer(step.data);
+    writer.Write(static_cast<uint8_t>(op));
+    writer.Write(entityIndex);
+
+    // Creation and destruction are discrete, there is nothing to merge into them
+    _canCoalesce = false;
+}
+
+bool SceneJournal::TryApply(const Step& step, const size_t offset, const bool undo)
+{
+    BinaryReader reader(step.data.data() + offset, step.data.size() - offset);
+    const OpCode op = static_cast<OpCode>(reader.Read<uint8_t>());
+    const uint32_t entityIndex = reader.Read<uint32_t>();
+
+    // Hibernated entities stay in the world, so this only fails if the entity was destroyed
+    Entity* const entity = TryResolve(entityIndex);
+    if (!entity) return false;
+
+    switch (op)
+    {
+        case OpCode::Create:
+        case OpCode::Destroy:
+        {
+            // Undoing a creation or redoing a destruction puts the subtree back to sleep
+            if ((op == OpCode::Create) == undo) return _scene->TryHibernate(entity);
+
+            Entity* woken{nullptr};
+            return _scene->TryWake(_entityTable.at(entityIndex), woken);
+        }
+
+        case OpCode::Write:
+        {
+            const entt::id_type id = reader.Read<entt::id_type>();
+            const uint32_t beforeSize = reader.Read<uint32_t>();
+            if (!undo) reader.Skip(beforeSize);
+            const uint32_t size = undo ? beforeSize : reader.Read<uint32_t>();
+
+            const ComponentOps* ops{nullptr};
+            if (!entity->IsValid() || !ComponentRegistry::TryGet(id, ops) || !ops->load) return false;
+
+            BinaryReader value(step.data.data() + offset + reader.GetPosition(), size);
+            ops->load(_scene->GetRegistry(), entity->GetHandle(), value);
+            return true;
+        }
+
+        case OpCode::Reparent:
+        {
+            const uint32_t oldParent = reader.Read<uint32_t>();
+            const uint32_t oldIndex = reader.Read<uint32_t>();
+            const uint32_t newParent = reader.Read<uint32_t>();
+            const uint32_t newIndex = reader.Read<uint32_t>();
+
+            const uint32_t parentIndex = undo ? oldParent : newParent;
+            const uint32_t index = undo ? oldIndex : newIndex;
+            if (!entity->IsValid()) return false;
+            if (parentIndex == NO_ENTITY) return TryPlace(entity, nullptr, index);
+
+            Entity* const parent = TryResolve(parentIndex);
+            return parent && TryPlace(entity, parent, index);
+        }
+    }
+    return false;
+}
+
+bool SceneJournal::TryPlace(Entity* const entity, Entity* const parent, const size_t index)
+{
+    Transform& transform = entity->GetTransform();
+
+    // TrySetParent() reports staying a root as no change, which is not a failure here
+    if (transform.GetParent() != parent && !transform.TrySetParent(parent)) return false;
+    return parent == nullptr || transform.TrySetSiblingIndex(index);
+}
+
+} // namespace velecs::ecs
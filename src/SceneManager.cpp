@@ -1,4 +1,5 @@
 #include "velecs/ecs/SceneManager.hpp"
+#include "velecs/ecs/MetricsExporter.hpp"
 #include "velecs/ecs/Scene.hpp"
 #include "velecs/ecs/World.hpp"
 
@@ -83,8 +84,13 @@ bool SceneManager::Internal_TryTransitionIfRequested(void* context)
     // No transition requested
     if (!_targetScene) return false;
 
-    // Cleanup current scene if one exists
-    if (_currentScene != nullptr) _currentScene->Cleanup(context);
+    const auto start = std::chrono::steady_clock::now();
+
+    // Cleanup current scene if one exists, its memory is released off the frame thread
+    if (_currentScene != nullptr)
+    {
+        _currentScene->Cleanup(context, _backgroundRelease ? _releaser.get() : nullptr);
+    }
 
     // Transition to target scene
     _currentScene = _targetScene;
@@ -92,6 +98,9 @@ bool SceneManager::Internal_TryTransitionIfRequested(void* context)
 
     // Initialize the new scene with context
     _currentScene->Init(context);
+
+    _lastTransitionDuration = std::chrono::steady_clock::now() - start;
+    ++_transitionCount;
     
     return true;
 }
@@ -101,6 +110,11 @@ bool SceneManager::Internal_TryProcess(void* context)
     auto scene = GetCurrentScene();
     if (scene == nullptr) return false;
 
+    // Last frame's events become readable, commands and systems send to the next frame
+    scene->SwapEventChannels();
+
+    // Apply structural changes requested by other threads before any system runs
+    scene->ProcessCommands();
     scene->Process(context);
     return true;
 }
@@ -129,6 +143,7 @@ bool SceneManager::Internal_TryProcessEntityCleanup()
     if (scene == nullptr) return false;
 
     scene->ProcessEntityCleanup();
+    TrySubmitMetrics();
     return true;
 }
 
@@ -140,4 +155,16 @@ bool SceneManager::Internal_TryProcessEntityCleanup()
 
 // Private Methods
 
+void SceneManager::TrySubmitMetrics()
+{
+    if (!_metricsExporter || !_metricsExporter->IsSnapshotDue()) return;
+
+    MetricsSnapshot snapshot;
+    snapshot.transitionCount = _transitionCount;
+    snapshot.lastTransitionDuration = _lastTransitionDuration;
+    if (_currentScene) _currentScene->CollectMetrics(snapshot);
+
+    _metricsExporter->TrySubmit(std::move(snapshot));
+}
+
 } // namespace velecs::ecs
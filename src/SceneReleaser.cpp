@@ -0,0 +1,82 @@
+#include "velecs/ecs/SceneReleaser.hpp"
+
+#include "velecs/ecs/Object.hpp"
+
+namespace velecs::ecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+SceneReleaser::SceneReleaser()
+{
+    _thread = std::thread(&SceneReleaser::Run, this);
+}
+
+SceneReleaser::~SceneReleaser()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_one();
+    if (_thread.joinable()) _thread.join();
+}
+
+// Public Methods
+
+void SceneReleaser::Submit(DetachedScene&& scene)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(std::move(scene));
+    }
+    _wakeup.notify_one();
+}
+
+void SceneReleaser::Flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() { return _pending.empty() && !_releasing; });
+}
+
+size_t SceneReleaser::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending.size() + (_releasing ? 1 : 0);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void SceneReleaser::Run()
+{
+    while (true)
+    {
+        DetachedScene scene;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _releasing = false;
+            if (_pending.empty()) _idle.notify_all();
+
+            // Scenes still queued at shutdown are released before the thread exits
+            _wakeup.wait(lock, [this]() { return _stopping || !_pending.empty(); });
+            if (_pending.empty()) return;
+
+            scene = std::move(_pending.front());
+            _pending.pop_front();
+            _releasing = true;
+        }
+
+        // Pools go first, components may still look at their owning entity while destroyed
+        scene.registry.reset();
+        scene.entities.clear();
+    }
+}
+
+} // namespace velecs::ecs
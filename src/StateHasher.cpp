@@ -0,0 +1,156 @@
+#include "velecs/ecs/StateHasher.hpp"
+
+#include <algorithm>
+
+namespace velecs::ecs {
+
+namespace {
+
+const uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t RotateLeft(const uint64_t value, const int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t Read64(const unsigned char* const bytes)
+{
+    uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint32_t Read32(const unsigned char* const bytes)
+{
+    uint32_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+inline uint64_t Round(uint64_t lane, const uint64_t input)
+{
+    lane += input * PRIME_2;
+    lane = RotateLeft(lane, 31);
+    return lane * PRIME_1;
+}
+
+inline uint64_t MergeRound(uint64_t hash, const uint64_t lane)
+{
+    hash ^= Round(0, lane);
+    return hash * PRIME_1 + PRIME_4;
+}
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+StateHasher::StateHasher(const uint64_t seed)
+    : _lanes{ seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1 }, _tail{}, _seed(seed) {}
+
+// Public Methods
+
+void StateHasher::Update(const void* const data, const size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = bytes + size;
+    _totalSize += size;
+
+    // Top up a partially filled stripe first
+    if (_tailSize > 0)
+    {
+        const size_t take = std::min(STRIPE_SIZE - _tailSize, size);
+        std::memcpy(_tail.data() + _tailSize, bytes, take);
+        _tailSize += take;
+        bytes += take;
+        if (_tailSize < STRIPE_SIZE) return;
+
+        ConsumeStripe(_tail.data());
+        _tailSize = 0;
+    }
+
+    // Bulk of the input goes straight through the four lanes
+    while (end - bytes >= static_cast<ptrdiff_t>(STRIPE_SIZE))
+    {
+        ConsumeStripe(bytes);
+        bytes += STRIPE_SIZE;
+    }
+
+    _tailSize = static_cast<size_t>(end - bytes);
+    if (_tailSize > 0) std::memcpy(_tail.data(), bytes, _tailSize);
+}
+
+uint64_t StateHasher::Finalize() const
+{
+    uint64_t hash;
+    if (_totalSize >= STRIPE_SIZE)
+    {
+        hash = RotateLeft(_lanes[0], 1) + RotateLeft(_lanes[1], 7) + RotateLeft(_lanes[2], 12) + RotateLeft(_lanes[3], 18);
+        for (const uint64_t lane : _lanes) hash = MergeRound(hash, lane);
+    }
+    else
+    {
+        hash = _seed + PRIME_5;
+    }
+    hash += _totalSize;
+
+    const unsigned char* bytes = _tail.data();
+    const unsigned char* const end = bytes + _tailSize;
+    for (; end - bytes >= 8; bytes += 8)
+    {
+        hash ^= Round(0, Read64(bytes));
+        hash = RotateLeft(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    if (end - bytes >= 4)
+    {
+        hash ^= static_cast<uint64_t>(Read32(bytes)) * PRIME_1;
+        hash = RotateLeft(hash, 23) * PRIME_2 + PRIME_3;
+        bytes += 4;
+    }
+    for (; bytes < end; ++bytes)
+    {
+        hash ^= (*bytes) * PRIME_5;
+        hash = RotateLeft(hash, 11) * PRIME_1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+bool StateHash::TryFindFirstMismatch(const StateHash& other, size_t& outIndex) const
+{
+    const size_t count = std::min(pools.size(), other.pools.size());
+    for (outIndex = 0; outIndex < count; ++outIndex)
+    {
+        if (pools[outIndex].id != other.pools[outIndex].id || pools[outIndex].hash != other.pools[outIndex].hash) return true;
+    }
+    return pools.size() != other.pools.size();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void StateHasher::ConsumeStripe(const unsigned char* const stripe)
+{
+    _lanes[0] = Round(_lanes[0], Read64(stripe));
+    _lanes[1] = Round(_lanes[1], Read64(stripe + 8));
+    _lanes[2] = Round(_lanes[2], Read64(stripe + 16));
+    _lanes[3] = Round(_lanes[3], Read64(stripe + 24));
+}
+
+} // namespace velecs::ecs
@@ -0,0 +1,133 @@
+#include "velecs/ecs/WorkerPool.hpp"
+
+#include <cassert>
+
+namespace velecs::ecs {
+
+namespace {
+
+/// @brief Set on pool threads while they run a task, to catch nested ParallelFor() calls.
+thread_local bool insideTask = false;
+
+/// @brief Index of the current thread within its pool, zero outside of worker threads.
+thread_local size_t currentThreadIndex = 0;
+
+/// @brief Pool of the current thread, nullptr outside of worker threads.
+thread_local const WorkerPool* currentPool = nullptr;
+
+} // namespace
+
+// Public Fields
+
+// Constructors and Destructors
+
+WorkerPool::WorkerPool(const size_t workerCount)
+    : _workerCount(workerCount) {}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_all();
+    for (auto& thread : _threads) thread.join();
+}
+
+// Public Methods
+
+size_t WorkerPool::GetDefaultWorkerCount()
+{
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+size_t WorkerPool::GetCurrentThreadIndex()
+{
+    return currentThreadIndex;
+}
+
+const WorkerPool* WorkerPool::GetCurrentPool()
+{
+    return currentPool;
+}
+
+void WorkerPool::ParallelFor(const size_t taskCount, const std::function<void(size_t)>& task)
+{
+    assert(!insideTask && "ParallelFor must not be called from inside a task");
+
+    // Not worth waking anyone up
+    if (_workerCount == 0 || taskCount <= 1)
+    {
+        for (size_t i = 0; i < taskCount; ++i) task(i);
+        return;
+    }
+
+    if (_threads.empty())
+    {
+        _threads.reserve(_workerCount);
+        for (size_t i = 0; i < _workerCount; ++i) _threads.emplace_back(&WorkerPool::Run, this, i + 1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _taskCount = taskCount;
+        _nextTask.store(0, std::memory_order_relaxed);
+        _busyWorkers = _threads.size();
+        ++_generation;
+    }
+    _wakeup.notify_all();
+
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finished.wait(lock, [this]() { return _busyWorkers == 0; });
+    _task = nullptr;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void WorkerPool::Run(const size_t threadIndex)
+{
+    currentThreadIndex = threadIndex;
+    currentPool = this;
+
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeup.wait(lock, [this, seenGeneration]() { return _stopping || _generation != seenGeneration; });
+            if (_stopping) return;
+            seenGeneration = _generation;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_busyWorkers;
+        }
+        _finished.notify_one();
+    }
+}
+
+void WorkerPool::RunTasks()
+{
+    insideTask = true;
+    for (size_t i = _nextTask.fetch_add(1, std::memory_order_relaxed); i < _taskCount;
+         i = _nextTask.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*_task)(i);
+    }
+    insideTask = false;
+}
+
+} // namespace velecs::ecs
@@ -18,6 +18,27 @@ size_t World::GetTotalCount() const
     return total;
 }
 
+size_t World::Compact()
+{
+    size_t reclaimed = 0;
+    for (auto it = _objects.begin(); it != _objects.end();)
+    {
+        ObjectMap& objects = it->second;
+        const size_t buckets = objects.bucket_count();
+        if (objects.empty())
+        {
+            reclaimed += buckets * sizeof(void*);
+            it = _objects.erase(it);
+            continue;
+        }
+
+        objects.rehash(0);
+        if (objects.bucket_count() < buckets) reclaimed += (buckets - objects.bucket_count()) * sizeof(void*);
+        ++it;
+    }
+    return reclaimed;
+}
+
 // Protected Fields
 
 // Protected Methods
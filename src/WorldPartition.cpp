@@ -0,0 +1,511 @@
+#include "velecs/ecs/WorldPartition.hpp"
+
+#include "velecs/ecs/BinaryStream.hpp"
+#include "velecs/ecs/Entity.hpp"
+#include "velecs/ecs/Scene.hpp"
+#include "velecs/ecs/components/Transform.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace velecs::ecs {
+
+// Public Fields
+
+size_t WorldPartition::CellKeyHash::operator()(const CellKey& key) const
+{
+    // Large primes spread neighbouring cells across buckets
+    return static_cast<size_t>(key.x) * 73856093u
+        ^ static_cast<size_t>(key.y) * 19349663u
+        ^ static_cast<size_t>(key.z) * 83492791u;
+}
+
+// Constructors and Destructors
+
+WorldPartition::WorldPartition(Scene* const scene, const float cellSize, const std::string& directory)
+    : _scene(scene), _cellSize(cellSize), _directory(directory)
+{
+    assert(_scene && "World partition requires a scene");
+    assert(_cellSize > 0.0f && "Cell size must be positive");
+
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if (error)
+    {
+        std::cerr << "[WARNING] Failed to create world partition directory '" << _directory << "'." << std::endl;
+    }
+
+    for (const auto& file : std::filesystem::directory_iterator(_directory, error))
+    {
+        CellKey key;
+        char tail{0};
+        const std::string name = file.path().filename().string();
+        if (std::sscanf(name.c_str(), "cell_%d_%d_%d.bi%c", &key.x, &key.y, &key.z, &tail) == 4 && tail == 'n')
+        {
+            _cellsOnDisk.insert(key);
+        }
+    }
+
+    _thread = std::thread(&WorldPartition::Run, this);
+}
+
+WorldPartition::~WorldPartition()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeup.notify_one();
+    if (_thread.joinable()) _thread.join();
+}
+
+// Public Methods
+
+WorldPartition::CellKey WorldPartition::GetCellKey(const math::Vec3& pos) const
+{
+    return CellKey{
+        static_cast<int32_t>(std::floor(pos.x / _cellSize)),
+        static_cast<int32_t>(std::floor(pos.y / _cellSize)),
+        static_cast<int32_t>(std::floor(pos.z / _cellSize)),
+    };
+}
+
+size_t WorldPartition::Rebuild()
+{
+    std::unordered_map<const Entity*, CellKey> rootCells;
+    for (auto& [key, cell] : _cells) cell.roots.clear();
+
+    _scene->GetRegistry().view<Transform>().each([&](auto handle, Transform& transform) {
+        if (transform.GetParent() != nullptr) return;
+
+        Entity* const root = transform.GetOwner();
+        const CellKey target = GetCellKey(transform.GetPos());
+
+        // Never let a root claim a cell whose contents are still on disk, unloading it would overwrite them
+        auto it = _cells.find(target);
+        const bool resident = it != _cells.end()
+            ? it->second.state == CellState::Loaded
+            : _cellsOnDisk.find(target) == _cellsOnDisk.end();
+
+        CellKey key = target;
+        if (!resident)
+        {
+            auto previous = _rootCells.find(root);
+            if (previous == _rootCells.end()) return;
+            key = previous->second;
+        }
+
+        Cell& cell = _cells[key];
+        if (cell.state == CellState::Unloaded) cell.state = CellState::Loaded;
+        cell.roots.push_back(root);
+        rootCells.emplace(root, key);
+    });
+
+    _rootCells = std::move(rootCells);
+    return _rootCells.size();
+}
+
+void WorldPartition::Update(const math::Vec3& focus)
+{
+    ApplyResults();
+
+    const CellKey center = GetCellKey(focus);
+    const int32_t radius = static_cast<int32_t>(_streamingRadius);
+    auto isWanted = [&](const CellKey& key) {
+        return std::abs(key.x - center.x) <= radius
+            && std::abs(key.y - center.y) <= radius
+            && std::abs(key.z - center.z) <= radius;
+    };
+
+    std::vector<CellKey> leaving;
+    for (const auto& [key, cell] : _cells)
+    {
+        if (cell.state != CellState::Unloaded && !isWanted(key)) leaving.push_back(key);
+    }
+    for (const CellKey& key : leaving) TryUnloadCell(key);
+
+    for (int32_t x = center.x - radius; x <= center.x + radius; ++x)
+    {
+        for (int32_t y = center.y - radius; y <= center.y + radius; ++y)
+        {
+            for (int32_t z = center.z - radius; z <= center.z + radius; ++z)
+            {
+                TryLoadCell(CellKey{x, y, z});
+            }
+        }
+    }
+
+    SpawnPending();
+}
+
+bool WorldPartition::TryLoadCell(const CellKey& key)
+{
+    Cell& cell = _cells[key];
+    if (cell.state != CellState::Unloaded) return false;
+
+    // Cells without a file are empty, there is nothing to read
+    if (_cellsOnDisk.find(key) == _cellsOnDisk.end())
+    {
+        cell.state = CellState::Loaded;
+        return true;
+    }
+
+    cell.state = CellState::Loading;
+    Submit(IoJob{key, false, {}});
+    return true;
+}
+
+bool WorldPartition::TryUnloadCell(const CellKey& key)
+{
+    auto it = _cells.find(key);
+    if (it == _cells.end()) return false;
+
+    Cell& cell = it->second;
+    switch (cell.state)
+    {
+        case CellState::Unloaded:
+            return false;
+
+        case CellState::Loading:
+            // The read result is discarded by ApplyResults()
+            cell.state = CellState::Unloaded;
+            return true;
+
+        case CellState::Spawning:
+            AbandonSpawn(key, cell);
+            return true;
+
+        case CellState::Loaded:
+            break;
+    }
+
+    std::vector<Entity*> entities;
+    std::vector<unsigned char> data = Encode(cell, entities);
+    _scene->DestroyEntities(entities);
+
+    for (Entity* const root : cell.roots) _rootCells.erase(root);
+    cell.roots.clear();
+    cell.state = CellState::Unloaded;
+
+    if (entities.empty() && _cellsOnDisk.find(key) == _cellsOnDisk.end()) return true;
+
+    _cellsOnDisk.insert(key);
+    Submit(IoJob{key, true, std::move(data)});
+    return true;
+}
+
+bool WorldPartition::IsCellLoaded(const CellKey& key) const
+{
+    auto it = _cells.find(key);
+    return it != _cells.end() && it->second.state == CellState::Loaded;
+}
+
+size_t WorldPartition::GetLoadedCellCount() const
+{
+    return static_cast<size_t>(std::count_if(_cells.begin(), _cells.end(),
+        [](const auto& entry) { return entry.second.state == CellState::Loaded; }));
+}
+
+void WorldPartition::Flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() { return _jobs.empty() && !_busy; });
+}
+
+void WorldPartition::SetSpawnBudget(const size_t budget)
+{
+    assert(budget > 0 && "Spawn budget must be positive");
+    _spawnBudget = budget;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void WorldPartition::Run()
+{
+    while (true)
+    {
+        IoJob job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeup.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+
+            // Drop pending reads on shutdown but never lose a write
+            while (!_jobs.empty() && !_jobs.front().write && _stopping) _jobs.pop_front();
+            if (_jobs.empty())
+            {
+                _idle.notify_all();
+                if (_stopping) return;
+                continue;
+            }
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+            _busy = true;
+        }
+
+        const std::string path = GetCellPath(job.key);
+        if (job.write)
+        {
+            if (!TryWriteFile(path, job.data))
+            {
+                std::cerr << "[WARNING] Failed to write world partition cell '" << path << "'." << std::endl;
+            }
+        }
+        else
+        {
+            IoResult result{job.key, false, {}};
+            result.ok = TryReadFile(path, result.data);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _results.push_back(std::move(result));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _busy = false;
+            if (_jobs.empty()) _idle.notify_all();
+        }
+    }
+}
+
+void WorldPartition::Submit(IoJob&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _wakeup.notify_one();
+}
+
+void WorldPartition::ApplyResults()
+{
+    std::vector<IoResult> results;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        results.swap(_results);
+    }
+
+    for (IoResult& result : results)
+    {
+        Cell& cell = _cells[result.key];
+
+        // The cell was unloaded, or unloaded and requested again, while the read was in flight
+        if (cell.state != CellState::Loading) continue;
+
+        if (!result.ok)
+        {
+            std::cerr << "[WARNING] Failed to read world partition cell '" << GetCellPath(result.key) << "'." << std::endl;
+            cell.state = CellState::Unloaded;
+            continue;
+        }
+
+        // One bad file on disk must not take the frame down, treat it like a failed read
+        if (!IsCellFileValid(result.data))
+        {
+            std::cerr << "[WARNING] Skipping world partition cell '" << GetCellPath(result.key) << "', it is corrupt or has an unsupported format version." << std::endl;
+            cell.state = CellState::Unloaded;
+            continue;
+        }
+
+        BinaryReader reader(result.data);
+        reader.Skip(sizeof(uint32_t));
+        cell.remaining = reader.Read<uint32_t>();
+        cell.position = reader.GetPosition();
+        cell.data = std::move(result.data);
+        cell.spawned.reserve(cell.remaining);
+        cell.state = CellState::Spawning;
+
+        _pendingSpawnCount += cell.remaining;
+        _spawnQueue.push_back(result.key);
+    }
+}
+
+void WorldPartition::SpawnPending()
+{
+    size_t budget = _spawnBudget;
+    while (budget > 0 && !_spawnQueue.empty())
+    {
+        const CellKey key = _spawnQueue.front();
+        Cell& cell = _cells.at(key);
+
+        const size_t count = std::min(budget, static_cast<size_t>(cell.remaining));
+        const std::vector<Entity*> created = _scene->CreateEntities(count);
+
+        // ApplyResults() validated the layout, only a codec reading a different amount than
+        // its payload size can still fail here
+        BinaryReader reader(cell.data.data() + cell.position, cell.data.size() - cell.position);
+        size_t thawed = 0;
+        try
+        {
+            for (Entity* const entity : created)
+            {
+                const uint32_t parentIndex = reader.Read<uint32_t>();
+                entity->SetName(reader.ReadString());
+                _scene->ThawComponents(entity, reader, nullptr);
+
+                Transform& transform = entity->GetTransform();
+                if (parentIndex == NO_PARENT)
+                {
+                    cell.roots.push_back(entity);
+                    _rootCells.emplace(entity, key);
+                }
+                else
+                {
+                    // Parents are written before their children, so they always exist already
+                    transform.TrySetParent(cell.spawned[parentIndex]);
+                }
+                cell.spawned.push_back(entity);
+                ++thawed;
+            }
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cerr << "[WARNING] Abandoning world partition cell '" << GetCellPath(key) << "': " << error.what() << std::endl;
+
+            // Entities created for this step but not thawed yet may lack their Transform
+            _scene->DestroyEntities(std::vector<Entity*>(created.begin() + thawed, created.end()));
+            AbandonSpawn(key, cell);
+            continue;
+        }
+
+        cell.position += reader.GetPosition();
+        cell.remaining -= static_cast<uint32_t>(count);
+        _pendingSpawnCount -= count;
+        budget -= count;
+
+        if (cell.remaining == 0)
+        {
+            cell.data = {};
+            cell.spawned = {};
+            cell.position = 0;
+            cell.state = CellState::Loaded;
+            _spawnQueue.pop_front();
+        }
+    }
+}
+
+void WorldPartition::AbandonSpawn(const CellKey& key, Cell& cell)
+{
+    _scene->DestroyEntities(cell.spawned);
+    for (Entity* const root : cell.roots) _rootCells.erase(root);
+
+    _pendingSpawnCount -= cell.remaining;
+    _spawnQueue.erase(std::remove(_spawnQueue.begin(), _spawnQueue.end(), key), _spawnQueue.end());
+
+    cell = Cell{};
+}
+
+bool WorldPartition::IsCellFileValid(const std::vector<unsigned char>& data)
+{
+    const entt::id_type transformId = entt::type_hash<Transform>::value();
+
+    // Reading past the end throws, which means the file is truncated
+    try
+    {
+        BinaryReader reader(data);
+        if (reader.Read<uint32_t>() != CELL_FORMAT_VERSION) return false;
+
+        const uint32_t count = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            // Pre-order puts every parent before its children
+            const uint32_t parentIndex = reader.Read<uint32_t>();
+            if (parentIndex != NO_PARENT && parentIndex >= i) return false;
+            reader.Skip(reader.Read<uint32_t>());
+
+            bool hasTransform = false;
+            const uint32_t componentCount = reader.Read<uint32_t>();
+            for (uint32_t c = 0; c < componentCount; ++c)
+            {
+                const entt::id_type id = reader.Read<entt::id_type>();
+                hasTransform |= (id == transformId);
+                reader.Skip(reader.Read<uint32_t>());
+            }
+            if (!hasTransform) return false;
+        }
+        return reader.IsAtEnd();
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+}
+
+std::vector<unsigned char> WorldPartition::Encode(Cell& cell, std::vector<Entity*>& outEntities)
+{
+    std::vector<unsigned char> data;
+    BinaryWriter writer(data);
+    writer.Write(uint32_t{CELL_FORMAT_VERSION});
+    writer.Write(uint32_t{0});
+
+    std::unordered_map<const Entity*, uint32_t> indices;
+    for (Entity* const root : cell.roots)
+    {
+        // Destroyed by gameplay, or attached to another subtree since the last Rebuild()
+        if (!root->IsValid() || root->GetTransform().GetParent() != nullptr) continue;
+
+        for (auto [entity, transform] : root->GetTransform().Traverse<TraversalOrder::PreOrder>())
+        {
+            const Entity* const parent = transform.GetParent();
+            const uint32_t parentIndex = parent ? indices.at(parent) : NO_PARENT;
+            writer.Write(parentIndex);
+            writer.WriteString(entity->GetName());
+            _scene->FreezeComponents(entity->GetHandle(), writer, nullptr);
+
+            indices.emplace(entity, static_cast<uint32_t>(outEntities.size()));
+            outEntities.push_back(entity);
+        }
+    }
+
+    writer.Patch(sizeof(uint32_t), static_cast<uint32_t>(outEntities.size()));
+    return data;
+}
+
+std::string WorldPartition::GetCellPath(const CellKey& key) const
+{
+    return (std::filesystem::path(_directory) /
+        ("cell_" + std::to_string(key.x) + "_" + std::to_string(key.y) + "_" + std::to_string(key.z) + ".bin")).string();
+}
+
+bool WorldPartition::TryWriteFile(const std::string& path, const std::vector<unsigned char>& data)
+{
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    return !error;
+}
+
+bool WorldPartition::TryReadFile(const std::string& path, std::vector<unsigned char>& outData)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    const std::streamsize size = file.tellg();
+    if (size < 0) return false;
+    outData.resize(static_cast<size_t>(size));
+
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(outData.data()), size);
+    return static_cast<bool>(file);
+}
+
+} // namespace velecs::ecs
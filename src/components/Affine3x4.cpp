@@ -0,0 +1,123 @@
+#include "velecs/ecs/components/Affine3x4.hpp"
+
+using namespace velecs::math;
+
+namespace velecs::ecs {
+
+// Public Fields
+
+const Affine3x4 Affine3x4::IDENTITY{{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+}};
+
+// Constructors and Destructors
+
+// Public Methods
+
+Affine3x4 Affine3x4::FromTRS(const Vec3& pos, const Quat& rot, const Vec3& scale)
+{
+    const float xx = rot.x * rot.x, yy = rot.y * rot.y, zz = rot.z * rot.z;
+    const float xy = rot.x * rot.y, xz = rot.x * rot.z, yz = rot.y * rot.z;
+    const float wx = rot.w * rot.x, wy = rot.w * rot.y, wz = rot.w * rot.z;
+
+    // Rotation columns scaled by the matching axis, then the translation
+    return Affine3x4{{
+        {(1.0f - 2.0f * (yy + zz)) * scale.x, 2.0f * (xy - wz) * scale.y, 2.0f * (xz + wy) * scale.z, pos.x},
+        {2.0f * (xy + wz) * scale.x, (1.0f - 2.0f * (xx + zz)) * scale.y, 2.0f * (yz - wx) * scale.z, pos.y},
+        {2.0f * (xz - wy) * scale.x, 2.0f * (yz + wx) * scale.y, (1.0f - 2.0f * (xx + yy)) * scale.z, pos.z},
+    }};
+}
+
+Mat4 Affine3x4::ToMat4() const
+{
+    // Mat4 is indexed by column, then row
+    Mat4 result = Mat4::IDENTITY;
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 4; ++col) result[col][row] = rows[row][col];
+    }
+    return result;
+}
+
+Affine3x4 Affine3x4::Inverse() const
+{
+    // Inverse of the linear part through its cofactors
+    const float c00 = rows[1][1] * rows[2][2] - rows[1][2] * rows[2][1];
+    const float c01 = rows[1][2] * rows[2][0] - rows[1][0] * rows[2][2];
+    const float c02 = rows[1][0] * rows[2][1] - rows[1][1] * rows[2][0];
+    const float det = rows[0][0] * c00 + rows[0][1] * c01 + rows[0][2] * c02;
+    if (det == 0.0f) return IDENTITY;
+
+    const float invDet = 1.0f / det;
+    Affine3x4 result;
+    result.rows[0][0] = c00 * invDet;
+    result.rows[0][1] = (rows[0][2] * rows[2][1] - rows[0][1] * rows[2][2]) * invDet;
+    result.rows[0][2] = (rows[0][1] * rows[1][2] - rows[0][2] * rows[1][1]) * invDet;
+    result.rows[1][0] = c01 * invDet;
+    result.rows[1][1] = (rows[0][0] * rows[2][2] - rows[0][2] * rows[2][0]) * invDet;
+    result.rows[1][2] = (rows[0][2] * rows[1][0] - rows[0][0] * rows[1][2]) * invDet;
+    result.rows[2][0] = c02 * invDet;
+    result.rows[2][1] = (rows[0][1] * rows[2][0] - rows[0][0] * rows[2][1]) * invDet;
+    result.rows[2][2] = (rows[0][0] * rows[1][1] - rows[0][1] * rows[1][0]) * invDet;
+
+    // The translation is undone after the linear part
+    for (int i = 0; i < 3; ++i)
+    {
+        result.rows[i][3] = -(result.rows[i][0] * rows[0][3] + result.rows[i][1] * rows[1][3] + result.rows[i][2] * rows[2][3]);
+    }
+    return result;
+}
+
+void Affine3x4::TransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const
+{
+    TransformRange(points, outPoints, count, 1.0f);
+}
+
+void Affine3x4::TransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const
+{
+    TransformRange(directions, outDirections, count, 0.0f);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void Affine3x4::TransformRange(const Vec3* const inputs, Vec3* const outputs, const size_t count, const float translation) const
+{
+#if VELECS_ECS_SSE
+    // Columns of the matrix, so each input is three broadcasts and multiply-adds
+    const __m128 col0 = _mm_setr_ps(rows[0][0], rows[1][0], rows[2][0], 0.0f);
+    const __m128 col1 = _mm_setr_ps(rows[0][1], rows[1][1], rows[2][1], 0.0f);
+    const __m128 col2 = _mm_setr_ps(rows[0][2], rows[1][2], rows[2][2], 0.0f);
+    const __m128 col3 = _mm_mul_ps(_mm_setr_ps(rows[0][3], rows[1][3], rows[2][3], 0.0f), _mm_set1_ps(translation));
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vec3& input = inputs[i];
+        __m128 sum = _mm_add_ps(col3, _mm_mul_ps(col0, _mm_set1_ps(input.x)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(col1, _mm_set1_ps(input.y)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(col2, _mm_set1_ps(input.z)));
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, sum);
+        outputs[i].x = lanes[0];
+        outputs[i].y = lanes[1];
+        outputs[i].z = lanes[2];
+    }
+#else
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vec3 input = inputs[i];
+        outputs[i].x = rows[0][0] * input.x + rows[0][1] * input.y + rows[0][2] * input.z + rows[0][3] * translation;
+        outputs[i].y = rows[1][0] * input.x + rows[1][1] * input.y + rows[1][2] * input.z + rows[1][3] * translation;
+        outputs[i].z = rows[2][0] * input.x + rows[2][1] * input.y + rows[2][2] * input.z + rows[2][3] * translation;
+    }
+#endif
+}
+
+} // namespace velecs::ecs
@@ -1,4 +1,5 @@
 #include "velecs/ecs/components/Transform.hpp"
+#include "velecs/ecs/Scene.hpp"
 
 using namespace velecs::math;
 
@@ -68,6 +69,16 @@ void Transform::SetRot(const Quat& newRot)
 }
 
 Mat4 Transform::GetModelMatrix() const
+{
+    return GetModelAffine().ToMat4();
+}
+
+Mat4 Transform::GetWorldMatrix() const
+{
+    return GetWorldAffine().ToMat4();
+}
+
+const Affine3x4& Transform::GetModelAffine() const
 {
     if (isModelDirty)
     {
@@ -77,7 +88,7 @@ Mat4 Transform::GetModelMatrix() const
     return cachedModelMat;
 }
 
-Mat4 Transform::GetWorldMatrix() const
+const Affine3x4& Transform::GetWorldAffine() const
 {
     if (isWorldDirty)
     {
@@ -87,10 +98,65 @@ Mat4 Transform::GetWorldMatrix() const
     return cachedWorldMat;
 }
 
+Mat4 Transform::GetWorldInverseMatrix() const
+{
+    return GetWorldInverseAffine().ToMat4();
+}
+
+const Affine3x4& Transform::GetWorldInverseAffine() const
+{
+    const Affine3x4& world = GetWorldAffine();
+    if (isWorldInverseDirty)
+    {
+        cachedWorldInverseMat = world.Inverse();
+        isWorldInverseDirty = false;
+    }
+    return cachedWorldInverseMat;
+}
+
+void Transform::TransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const
+{
+    GetWorldAffine().TransformPoints(points, outPoints, count);
+}
+
+void Transform::InverseTransformPoints(const Vec3* const points, Vec3* const outPoints, const size_t count) const
+{
+    GetWorldInverseAffine().TransformPoints(points, outPoints, count);
+}
+
+void Transform::TransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const
+{
+    GetWorldAffine().TransformDirections(directions, outDirections, count);
+}
+
+void Transform::InverseTransformDirections(const Vec3* const directions, Vec3* const outDirections, const size_t count) const
+{
+    GetWorldInverseAffine().TransformDirections(directions, outDirections, count);
+}
+
 bool Transform::TrySetParent(Entity* const newParent)
 {
+    // A null parent makes this a root transform.
+    if (!newParent)
+    {
+        // Already a root, so no change needed.
+        if (_parent == nullptr) return false;
+        if (_parent->IsValid())
+        {
+            auto& oldParentTransform = _parent->GetTransform();
+            oldParentTransform._children.erase(
+                std::remove(oldParentTransform._children.begin(),
+                           oldParentTransform._children.end(), GetOwner()),
+                oldParentTransform._children.end()
+            );
+        }
+        _parent = nullptr;
+        SetWorldDirty();
+        return true;
+    }
+
     // Only use a valid entity as a parent.
-    if (!newParent || !newParent->IsValid()) return false;
+    if (!newParent->IsValid()) return false;
 
     Entity* const owner = GetOwner();
 
@@ -188,7 +254,7 @@ bool Transform::TryRemoveChild(const size_t index)
 
 size_t Transform::GetSiblingIndex() const
 {
-    if (!_parent->IsValid()) return 0;
+    if (!_parent || !_parent->IsValid()) return 0;
     
     const auto& siblings = _parent->GetTransform()._children;
     auto it = std::find(siblings.begin(), siblings.end(), GetOwner());
@@ -198,7 +264,7 @@ size_t Transform::GetSiblingIndex() const
 
 bool Transform::TrySetSiblingIndex(const size_t index)
 {
-    if (!_parent->IsValid()) return false;
+    if (!_parent || !_parent->IsValid()) return false;
     
     auto& parentTransform = _parent->GetTransform();
     auto& siblings = parentTransform._children;
@@ -273,6 +339,41 @@ Entity* Transform::GetRoot() const
     return current;
 }
 
+void Transform::HashState(StateHasher& hasher) const
+{
+    hasher.Update(pos);
+    hasher.Update(scale);
+    hasher.Update(rot);
+
+    hasher.Update(_parent ? _parent->GetHandle() : static_cast<entt::entity>(entt::null));
+    hasher.Update(static_cast<uint64_t>(_children.size()));
+    for (const Entity* child : _children) hasher.Update(child->GetHandle());
+}
+
+void Transform::Serialize(BinaryWriter& writer) const
+{
+    writer.Write(pos);
+    writer.Write(scale);
+    writer.Write(rot);
+}
+
+void Transform::Deserialize(BinaryReader& reader)
+{
+    pos = reader.Read<Vec3>();
+    scale = reader.Read<Vec3>();
+    rot = reader.Read<Quat>();
+
+    // Thawed transforms are not owned yet, so flag directly instead of going through SetDirty()
+    if (GetOwner() == nullptr)
+    {
+        isModelDirty = true;
+        isWorldDirty = true;
+        isWorldInverseDirty = true;
+        return;
+    }
+    SetDirty();
+}
+
 // Protected Fields
 
 // Protected Methods
@@ -281,25 +382,31 @@ Entity* Transform::GetRoot() const
 
 // Private Methods
 
-Mat4 Transform::CalculateModel() const
+Affine3x4 Transform::CalculateModel() const
 {
-    Mat4 T = Mat4::FromPosition(pos);
-    Mat4 R = rot.ToMatrix();
-    Mat4 S = Mat4::FromScale(scale);
+    VELECS_ECS_COUNT(GetScene(), ModelRecomputes);
+    return ComposeModel();
+}
 
-    return T * R * S;
+Affine3x4 Transform::ComposeModel() const
+{
+    return Affine3x4::FromTRS(pos, rot, scale);
 }
 
-Mat4 Transform::CalculateWorld() const
+Affine3x4 Transform::CalculateWorld() const
 {
+    VELECS_ECS_COUNT(GetScene(), WorldRecomputes);
+
     // If there is no parent then the model is the world matrix.
-    if (!_parent) return GetModelMatrix();
-    return _parent->GetTransform().GetWorldMatrix() * GetModelMatrix();
+    if (!_parent) return GetModelAffine();
+    return _parent->GetTransform().GetWorldAffine() * GetModelAffine();
 }
 
 void Transform::SetWorldDirty()
 {
+    VELECS_ECS_COUNT(GetScene(), DirtyVisits);
     isWorldDirty = true;
+    isWorldInverseDirty = true;
     for (const Entity* child : _children)
     {
         if (child->IsValid()) child->GetTransform().SetWorldDirty(); 
@@ -312,4 +419,32 @@ void Transform::SetDirty()
     SetWorldDirty();
 }
 
+size_t Transform::GetSubtreeSize() const
+{
+    size_t size = 1;
+    for (const Entity* child : _children) size += child->GetTransform().GetSubtreeSize();
+    return size;
+}
+
+size_t Transform::PropagateWorld(const Affine3x4& parentWorld) const
+{
+    size_t modelRecomputes = 0;
+    if (isModelDirty)
+    {
+        cachedModelMat = ComposeModel();
+        isModelDirty = false;
+        ++modelRecomputes;
+    }
+
+    cachedWorldMat = parentWorld * cachedModelMat;
+    isWorldDirty = false;
+    isWorldInverseDirty = true;
+
+    for (const Entity* child : _children)
+    {
+        modelRecomputes += child->GetTransform().PropagateWorld(cachedWorldMat);
+    }
+    return modelRecomputes;
+}
+
 } // namespace velecs::ecs
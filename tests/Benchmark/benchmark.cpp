@@ -0,0 +1,126 @@
+#include <velecs/ecs/Common.hpp>
+#include <velecs/ecs/SceneManager.hpp>
+using namespace velecs::ecs;
+
+#include <velecs/math/Vec3.hpp>
+using namespace velecs::math;
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Benchmark components and scenes
+class Velocity : public Component {
+public:
+    Vec3 vel{Vec3::ZERO};
+
+    void HashState(StateHasher& hasher) const { hasher.Update(vel); }
+};
+
+class BenchmarkScene : public Scene {
+public:
+    BenchmarkScene(World* const world, const std::string& name, size_t systemCapacity)
+        : Scene(world, name, systemCapacity) {}
+
+    void OnEnter(void*) override {}
+};
+
+// Helpers
+
+/// @brief Creates a scene and makes it the current scene of a world.
+Scene* EnterScene(World& world, const std::string& name)
+{
+    Scene* scene = Scene::Create<BenchmarkScene>(&world, name);
+    world.scenes->TryRequestSceneTransition(scene);
+    world.scenes->Internal_TryTransitionIfRequested(nullptr);
+    return scene;
+}
+
+/// @brief Runs a function several times.
+/// @return The fastest run, in milliseconds, which is the least disturbed by the OS.
+double Measure(const size_t runs, const std::function<void()>& run)
+{
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < runs; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/// @brief Prints one result line.
+void Report(const std::string& name, const double milliseconds)
+{
+    std::cout << "  " << name << ": " << milliseconds << " ms" << std::endl;
+}
+
+/// @brief Keeps results alive so the optimizer cannot drop the measured work.
+volatile uint64_t sink = 0;
+
+// ========== State Hashing ==========
+
+void BenchmarkStateHash()
+{
+    const size_t entityCount = 100000;
+
+    World world;
+    Scene* scene = EnterScene(world, "State Hash");
+    EntityReservation block = scene->ReserveEntities(entityCount);
+    scene->CommitReservation(block);
+    scene->AddComponents<Velocity>(block.GetEntities());
+
+    std::cout << "State hash, " << entityCount << " entities with Transform and Velocity (target: well under 1 ms)" << std::endl;
+    Report("ComputeStateHash", Measure(20, [scene]() { sink = sink ^ scene->ComputeStateHash().combined; }));
+}
+
+// ========== Query Prefetching ==========
+
+/// @brief Fills a scene whose entities all own a Transform and a Velocity.
+/// @param scattered True to add the Velocities in random order, so iterating one pool jumps
+///        around the other one instead of walking both in step.
+Scene* FillQueryScene(World& world, const std::string& name, const size_t entityCount, const bool scattered)
+{
+    Scene* scene = EnterScene(world, name);
+    EntityReservation block = scene->ReserveEntities(entityCount);
+    scene->CommitReservation(block);
+
+    std::vector<Entity*> entities = block.GetEntities();
+    if (scattered) std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+    scene->AddComponents<Velocity>(entities);
+    return scene;
+}
+
+void BenchmarkQueryPrefetching()
+{
+    const size_t entityCount = 1000000;
+
+    std::cout << "Query<Transform, Velocity>, " << entityCount << " entities" << std::endl;
+    for (const bool scattered : {false, true})
+    {
+        World world;
+        Scene* scene = FillQueryScene(world, "Query", entityCount, scattered);
+        Report(scattered ? "Scattered pools" : "Pools in step", Measure(10, [scene]() {
+            float sum = 0.0f;
+            scene->Query<Transform, Velocity>([&sum](Entity*, Transform& transform, Velocity& velocity) {
+                sum += transform.GetPos().x + velocity.vel.x;
+            });
+            sink = sink + static_cast<uint64_t>(sum);
+        }));
+    }
+}
+
+int main()
+{
+    BenchmarkStateHash();
+    BenchmarkQueryPrefetching();
+    return 0;
+}
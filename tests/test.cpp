@@ -7,6 +7,14 @@ using namespace velecs::math;
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+
 // Test fixtures and helper classes
 class ExampleTag : public Tag {};
 
@@ -21,6 +29,54 @@ public:
     Vec3 vel{Vec3::ZERO};
 };
 
+class Depth : public Component {
+public:
+    float z{0.0f};
+};
+
+struct ByDepth {
+    bool operator()(const Depth& lhs, const Depth& rhs) const { return lhs.z < rhs.z; }
+};
+
+class Anchor : public Component {
+public:
+    int id{0};
+};
+
+namespace velecs::ecs {
+
+template<>
+struct ComponentTraits<Anchor> : DefaultComponentTraits {
+    static constexpr bool inPlaceDelete = true;
+    static constexpr size_t pageSize = 64;
+};
+
+} // namespace velecs::ecs
+
+std::atomic<size_t> gpuHandlesDestroyed{0};
+std::atomic<bool> gpuHandleDestroyedOffFrameThread{false};
+const std::thread::id frameThreadId = std::this_thread::get_id();
+
+class GpuHandle : public Component {
+public:
+    uint32_t handle{0};
+
+    ~GpuHandle() override
+    {
+        ++gpuHandlesDestroyed;
+        if (std::this_thread::get_id() != frameThreadId) gpuHandleDestroyedOffFrameThread = true;
+    }
+};
+
+namespace velecs::ecs {
+
+template<>
+struct ComponentTraits<GpuHandle> : DefaultComponentTraits {
+    static constexpr bool mainThreadDestruction = true;
+};
+
+} // namespace velecs::ecs
+
 struct SystemContext {
     Scene* scene;
     float deltaTime;
@@ -102,6 +158,17 @@ public:
     }
 };
 
+std::vector<std::pair<Entity*, int>> fusedCalls;
+
+template<int Stage>
+struct RecordStage {
+    void operator()(void*, Entity* entity, Velocity& velocity) const
+    {
+        fusedCalls.emplace_back(entity, Stage);
+        velocity.vel = velocity.vel * 10.0f + Vec3::RIGHT * static_cast<float>(Stage);
+    }
+};
+
 // Test fixture for ECS tests
 class ECSTest : public ::testing::Test {
 protected:
@@ -179,6 +246,1246 @@ TEST_F(ECSTest, SceneTransition2)
     EXPECT_EQ(scene->GetName(), testScene->GetName());
 }
 
+// Statistics tests
+#if VELECS_ECS_STATS_ENABLED
+TEST_F(ECSTest, SceneStatsCountHotPaths)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition("Test Scene"));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Scene* scene = sceneManager->GetCurrentScene();
+    Entity* parent = Entity::Create(scene).WithName("Parent Entity");
+    Entity* child = Entity::Create(scene).WithName("Child Entity").WithParent(parent);
+    scene->ResetStats();
+
+    parent->GetTransform().SetPos(Vec3::RIGHT);
+    child->GetTransform().GetWorldMatrix();
+
+    SceneStats stats = scene->GetStats();
+    EXPECT_EQ(stats.dirtyVisits, 2u) << "Moving the parent should visit the parent and its child";
+    EXPECT_EQ(stats.worldRecomputes, 2u) << "Child world matrix should pull the parent world matrix";
+    EXPECT_EQ(stats.modelRecomputes, 2u);
+
+    EXPECT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    EXPECT_EQ(scene->GetStats().dirtyVisits, 0u) << "Counters should roll over at the end of the frame";
+    EXPECT_EQ(scene->GetFrameStats().dirtyVisits, 2u);
+}
+#endif
+
+TEST_F(ECSTest, MetricsSerializeOpenMetrics)
+{
+    MetricsSnapshot snapshot;
+    MetricsSnapshot::SceneMetrics scene;
+    scene.name = "Main \"Scene\"";
+    scene.entityCount = 3;
+    snapshot.scenes.push_back(scene);
+
+    const std::string text = MetricsExporter::Serialize(snapshot);
+
+    EXPECT_NE(text.find("velecs_ecs_entities{scene=\"Main \\\"Scene\\\"\"} 3\n"), std::string::npos)
+        << "Label values should be escaped";
+    EXPECT_EQ(text.rfind("# EOF\n"), text.size() - 6) << "Exposition must end with the EOF marker";
+}
+
+// Command queue tests
+TEST_F(ECSTest, CrossThreadSpawnCommands)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    const size_t baseline = scene->GetEntityCount();
+
+    std::vector<std::thread> producers;
+    for (size_t i{0}; i < 4; ++i)
+    {
+        producers.emplace_back([scene]() {
+            for (size_t j{0}; j < 100; ++j)
+            {
+                EXPECT_TRUE(scene->TryEnqueueSpawn([](Entity* const entity) { entity->SetName("Spawned"); }));
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_EQ(scene->GetEntityCount(), baseline) << "Commands must not apply until the frame drains them";
+    EXPECT_TRUE(sceneManager->Internal_TryProcess(nullptr));
+    EXPECT_EQ(scene->GetEntityCount(), baseline + 400);
+}
+
+// Reservation tests
+TEST_F(ECSTest, ReservedEntitiesCommitStagedComponents)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    const size_t baseline = scene->GetEntityCount();
+    EntityReservation wave = scene->ReserveEntities(256, 4);
+    EXPECT_EQ(scene->GetEntityCount(), baseline + 256);
+
+    std::vector<std::thread> workers;
+    for (size_t i{0}; i < wave.GetStagingCount(); ++i)
+    {
+        workers.emplace_back([&wave, i]() {
+            auto [begin, end] = wave.GetRange(i);
+            for (size_t j{begin}; j < end; ++j)
+            {
+                wave.GetStaging(i).Stage<Velocity>(wave[j]).vel = Vec3::ONE;
+                if (j % 2 == 0) wave.GetStaging(i).StageTag<ExampleTag>(wave[j]);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    EXPECT_FALSE(wave[0]->HasComponent<Velocity>()) << "Staged components must not apply before the commit";
+    EXPECT_EQ(scene->CommitReservation(wave), 256u + 128u);
+    EXPECT_EQ(scene->CommitReservation(wave), 0u);
+
+    for (Entity* entity : wave.GetEntities())
+    {
+        const Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryGetComponent<Velocity>(velocity));
+        EXPECT_EQ(velocity->GetOwner(), entity);
+    }
+    EXPECT_TRUE(wave[0]->HasTag<ExampleTag>());
+    EXPECT_FALSE(wave[1]->HasTag<ExampleTag>());
+}
+
+// Parallel execution tests
+TEST_F(ECSTest, DeterministicParallelQueryMatchesSerial)
+{
+    auto runSimulation = [](const size_t workerCount) {
+        World world;
+        world.workers = std::make_unique<WorkerPool>(workerCount);
+        Scene* scene = Scene::Create<TestScene>(&world, "Lockstep Scene");
+        EXPECT_TRUE(world.scenes->TryRequestSceneTransition(scene));
+        EXPECT_TRUE(world.scenes->Internal_TryTransitionIfRequested(nullptr));
+
+        scene->SetDeterministic(true);
+        scene->SetParallelChunkSize(16);
+        for (size_t i{0}; i < 200; ++i)
+        {
+            Entity* unit = Entity::Create(scene).WithName("Unit " + std::to_string(i));
+            Velocity* velocity{nullptr};
+            EXPECT_TRUE(unit->TryAddComponent<Velocity>(velocity));
+        }
+
+        scene->ParallelQuery<Velocity>([](CommandBuffer& commands, Entity* entity, Velocity& velocity) {
+            velocity.vel = Vec3::ONE * static_cast<float>(commands.GetChunkIndex());
+            if (commands.GetChunkIndex() % 3 == 0)
+            {
+                const std::string name = entity->GetName() + " Child";
+                commands.Spawn([name](Entity* const spawned) {
+                    Velocity* velocity{nullptr};
+                    spawned->SetName(name);
+                    spawned->TryAddComponent<Velocity>(velocity);
+                });
+            }
+        });
+
+        std::vector<std::string> names;
+        scene->Query<Velocity, Transform>([&names](Entity* entity, Velocity& velocity, Transform&) {
+            names.push_back(entity->GetName() + " " + std::to_string(velocity.vel.x));
+        });
+        return names;
+    };
+
+    const std::vector<std::string> serial = runSimulation(0);
+    EXPECT_EQ(runSimulation(3), serial);
+    EXPECT_GT(serial.size(), 200u);
+}
+
+// State hashing tests
+TEST_F(ECSTest, StateHashDetectsDivergence)
+{
+    auto buildScene = [](World& world) {
+        Scene* scene = Scene::Create<TestScene>(&world, "Hashed Scene");
+        EXPECT_TRUE(world.scenes->TryRequestSceneTransition(scene));
+        EXPECT_TRUE(world.scenes->Internal_TryTransitionIfRequested(nullptr));
+
+        Entity* parent = Entity::Create(scene).WithName("Parent");
+        Entity::Create(scene).WithName("Child").WithParent(parent).WithPos(Vec3::RIGHT);
+        EXPECT_TRUE(parent->TryAddTag<ExampleTag>());
+        return scene;
+    };
+
+    World worldA;
+    World worldB;
+    Scene* sceneA = buildScene(worldA);
+    Scene* sceneB = buildScene(worldB);
+
+    const StateHash hashA = sceneA->ComputeStateHash();
+    EXPECT_EQ(hashA, sceneB->ComputeStateHash()) << "Identical scenes in different worlds must hash equally";
+
+    worldB.TryGet<Entity>("Parent").front()->GetTransform().SetPos(Vec3::BACKWARD);
+    const StateHash hashB = sceneB->ComputeStateHash();
+    EXPECT_NE(hashA, hashB);
+
+    size_t mismatch{0};
+    ASSERT_TRUE(hashA.TryFindFirstMismatch(hashB, mismatch));
+    EXPECT_TRUE(hashA.pools[mismatch].hasValues) << "Only the Transform pool values changed";
+}
+
+// Hibernation tests
+TEST_F(ECSTest, HibernatedSubtreeWakesIntact)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Entity* anchor = Entity::Create(scene).WithName("Anchor");
+    Entity* room = Entity::Create(scene).WithName("Room").WithParent(anchor);
+    Entity* prop = Entity::Create(scene).WithName("Prop").WithParent(room).WithPos(Vec3::RIGHT);
+    Velocity* velocity{nullptr};
+    ASSERT_TRUE(prop->TryAddComponent<Velocity>(velocity));
+    velocity->vel = Vec3::ONE;
+    ASSERT_TRUE(room->TryAddTag<ExampleTag>());
+
+    const size_t baseline = scene->GetEntityCount();
+    ASSERT_TRUE(scene->TryHibernate(room));
+    EXPECT_EQ(scene->GetEntityCount(), baseline - 2);
+    EXPECT_EQ(scene->GetHibernatedCount(), 2u);
+    EXPECT_FALSE(prop->IsValid());
+    EXPECT_EQ(anchor->GetTransform().GetChildCount(), 0u);
+
+    Entity* woken{nullptr};
+    ASSERT_TRUE(scene->TryWake(room->GetUuid(), woken));
+    EXPECT_EQ(woken, room);
+    EXPECT_FALSE(scene->IsHibernated(room->GetUuid()));
+    EXPECT_EQ(scene->GetEntityCount(), baseline);
+
+    EXPECT_EQ(anchor->GetTransform().TryGetChild(0), room);
+    EXPECT_EQ(prop->GetTransform().GetParent(), room);
+    EXPECT_EQ(prop->GetTransform().GetPos(), Vec3::RIGHT);
+    EXPECT_TRUE(room->HasTag<ExampleTag>());
+
+    const Velocity* restored{nullptr};
+    ASSERT_TRUE(prop->TryGetComponent<Velocity>(restored));
+    EXPECT_EQ(restored->vel, Vec3::ONE);
+    EXPECT_EQ(restored->GetOwner(), prop);
+}
+
+// World partition tests
+TEST_F(ECSTest, WorldPartitionRoundTripsCellsAndSkipsBadFiles)
+{
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "velecs-ecs-partition-test";
+    fs::remove_all(directory);
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    const Vec3 palletPos{1.0f, 2.0f, 3.0f};
+    Entity* pallet = Entity::Create(scene).WithName("Pallet").WithPos(palletPos);
+    Entity::Create(scene).WithName("Crate").WithParent(pallet).WithPos(Vec3::RIGHT);
+    Entity::Create(scene).WithName("Lamp").WithPos(Vec3{15.0f, 0.0f, 0.0f});
+
+    {
+        WorldPartition partition(scene, 10.0f, directory.string());
+        EXPECT_EQ(partition.Rebuild(), 2u);
+        const WorldPartition::CellKey origin = partition.GetCellKey(Vec3::ZERO);
+        ASSERT_TRUE(partition.IsCellLoaded(origin));
+
+        // Saving destroys the cell's subtrees, loading recreates them with new UUIDs
+        const size_t entityCount = scene->GetEntityCount();
+        ASSERT_TRUE(partition.TryUnloadCell(origin));
+        partition.Flush();
+        EXPECT_EQ(scene->GetEntityCount(), entityCount - 2);
+        EXPECT_TRUE(world->TryGet<Entity>("Crate").empty());
+
+        ASSERT_TRUE(partition.TryLoadCell(origin));
+        partition.Flush();
+        partition.Update(Vec3::ZERO);
+        ASSERT_TRUE(partition.IsCellLoaded(origin));
+        EXPECT_EQ(scene->GetEntityCount(), entityCount);
+
+        const std::vector<Entity*> crates = world->TryGet<Entity>("Crate");
+        ASSERT_EQ(crates.size(), 1u);
+        Entity* const loadedPallet = crates.front()->GetTransform().GetParent();
+        ASSERT_NE(loadedPallet, nullptr);
+        EXPECT_EQ(loadedPallet->GetName(), "Pallet");
+        EXPECT_EQ(loadedPallet->GetTransform().GetPos(), palletPos);
+        EXPECT_EQ(crates.front()->GetTransform().GetPos(), Vec3::RIGHT);
+
+        // Bad files are skipped instead of taking the frame down, and spawn nothing
+        ASSERT_TRUE(partition.TryUnloadCell(origin));
+        partition.Flush();
+        const size_t unloadedCount = scene->GetEntityCount();
+        std::vector<fs::path> cellFiles;
+        for (const fs::directory_entry& entry : fs::directory_iterator(directory)) cellFiles.push_back(entry.path());
+        ASSERT_EQ(cellFiles.size(), 1u);
+
+        std::vector<char> original(fs::file_size(cellFiles.front()));
+        std::ifstream(cellFiles.front(), std::ios::binary).read(original.data(), static_cast<std::streamsize>(original.size()));
+
+        const auto writeUint32 = [](std::vector<char>& bytes, const size_t offset, const uint32_t value) {
+            std::copy_n(reinterpret_cast<const char*>(&value), sizeof(value), bytes.begin() + offset);
+        };
+        std::vector<char> unsupportedVersion = original;
+        writeUint32(unsupportedVersion, 0, 99);
+        std::vector<char> parentAfterChild = original;
+        writeUint32(parentAfterChild, 2 * sizeof(uint32_t), 1);
+        std::vector<char> truncated(original.begin(), original.end() - 1);
+
+        for (const std::vector<char>* corrupt : {&unsupportedVersion, &parentAfterChild, &truncated})
+        {
+            std::ofstream(cellFiles.front(), std::ios::binary | std::ios::trunc)
+                .write(corrupt->data(), static_cast<std::streamsize>(corrupt->size()));
+
+            ASSERT_TRUE(partition.TryLoadCell(origin));
+            partition.Flush();
+            EXPECT_NO_THROW(partition.Update(Vec3::ZERO));
+            EXPECT_FALSE(partition.IsCellLoaded(origin));
+            EXPECT_EQ(scene->GetEntityCount(), unloadedCount);
+            EXPECT_TRUE(world->TryGet<Entity>("Crate").empty());
+
+            // The cell is back to unloaded, so the next frame does not trip over it again
+            EXPECT_NO_THROW(partition.Update(Vec3::ZERO));
+        }
+    }
+
+    fs::remove_all(directory);
+}
+
+// Journal tests
+TEST_F(ECSTest, JournalUndoesCoalescedEdits)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    SceneJournal journal(scene);
+    Entity* folder = journal.CreateEntity().WithName("Folder");
+    Entity* prop = journal.CreateEntity().WithName("Prop");
+    journal.BreakCoalescing();
+
+    // A drag emits many writes but records a single step
+    for (int i{1}; i <= 10; ++i)
+    {
+        ASSERT_TRUE(journal.TryEdit<Transform>(prop, [i](Transform& transform) {
+            transform.SetPos(Vec3::RIGHT * static_cast<float>(i));
+        }));
+    }
+    journal.BreakCoalescing();
+    ASSERT_TRUE(journal.TrySetParent(prop, folder));
+    EXPECT_EQ(journal.GetUndoCount(), 4u);
+
+    ASSERT_TRUE(journal.TryUndo());
+    EXPECT_EQ(prop->GetTransform().GetParent(), nullptr);
+    ASSERT_TRUE(journal.TryUndo());
+    EXPECT_EQ(prop->GetTransform().GetPos(), Vec3::ZERO);
+
+    ASSERT_TRUE(journal.TryUndo());
+    EXPECT_FALSE(prop->IsValid());
+    ASSERT_TRUE(journal.TryRedo());
+    ASSERT_TRUE(journal.TryRedo());
+    ASSERT_TRUE(journal.TryRedo());
+    EXPECT_TRUE(prop->IsValid());
+    EXPECT_EQ(prop->GetTransform().GetParent(), folder);
+    EXPECT_EQ(prop->GetTransform().GetPos(), Vec3::RIGHT * 10.0f);
+}
+
+TEST_F(ECSTest, JournalForgetsEntitiesOfTrimmedSteps)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    SceneJournal journal(scene, 4);
+
+    // Staying a root is no change, so nothing is recorded
+    Entity* root = Entity::Create(scene).WithName("Root");
+    EXPECT_FALSE(root->GetTransform().TrySetParent(nullptr));
+    EXPECT_FALSE(journal.TrySetParent(root, nullptr));
+    EXPECT_EQ(journal.GetUndoCount(), 0u);
+
+    Entity* prop{nullptr};
+    for (int i{0}; i < 1000; ++i)
+    {
+        prop = Entity::Create(scene).WithName("Prop");
+        journal.BreakCoalescing();
+        ASSERT_TRUE(journal.TryEdit<Transform>(prop, [](Transform& transform) { transform.SetPos(Vec3::RIGHT); }));
+    }
+    EXPECT_EQ(journal.GetUndoCount(), 4u);
+
+    // Only the entities of the four kept steps stay referenced, not all 1000
+    EXPECT_LT(journal.GetByteSize(), 200 * sizeof(Uuid));
+
+    for (int i{0}; i < 4; ++i) ASSERT_TRUE(journal.TryUndo());
+    EXPECT_EQ(prop->GetTransform().GetPos(), Vec3::ZERO);
+    EXPECT_FALSE(journal.TryUndo());
+}
+
+// Storage trait tests
+TEST_F(ECSTest, ComponentTraitsReachEnTTStorage)
+{
+    static_assert(entt::component_traits<Anchor>::in_place_delete, "Anchor traits must reach EnTT");
+    static_assert(entt::component_traits<Anchor>::page_size == 64, "Anchor traits must reach EnTT");
+    static_assert(!entt::component_traits<Velocity>::in_place_delete, "Defaults must reach EnTT");
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Entity* first = Entity::Create(scene).WithName("First");
+    Entity* second = Entity::Create(scene).WithName("Second");
+    Anchor* firstAnchor{nullptr};
+    Anchor* secondAnchor{nullptr};
+    ASSERT_TRUE(first->TryAddComponent<Anchor>(firstAnchor));
+    ASSERT_TRUE(second->TryAddComponent<Anchor>(secondAnchor));
+    secondAnchor->id = 2;
+
+    // Removal leaves a tombstone instead of moving the last anchor into the hole
+    ASSERT_TRUE(first->TryRemoveComponent<Anchor>());
+    Anchor* stillThere{nullptr};
+    ASSERT_TRUE(second->TryGetComponent<Anchor>(stillThere));
+    EXPECT_EQ(stillThere, secondAnchor);
+    EXPECT_EQ(stillThere->id, 2);
+
+    const CompactionReport report = scene->Compact();
+    EXPECT_EQ(report.tombstonesRemoved, 1u);
+    ASSERT_TRUE(second->TryGetComponent<Anchor>(stillThere));
+    EXPECT_EQ(stillThere->id, 2);
+}
+
+// Pool warm-up tests
+TEST_F(ECSTest, DeclaredPoolsAreReservedBeforeFirstUse)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    scene->DeclareComponent<Velocity>(1000);
+    scene->DeclareComponent<ExampleTag>();
+    EXPECT_EQ(scene->GetDeclaredComponentCount(), 2u);
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    const size_t capacity = scene->GetPoolCapacity<Velocity>();
+    EXPECT_GE(capacity, 1000u);
+
+    // Filling the declared capacity never grows the pool
+    for (int i{0}; i < 1000; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithName("Mover");
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Velocity>(velocity));
+    }
+    EXPECT_EQ(scene->GetPoolCapacity<Velocity>(), capacity);
+
+    // A smaller declaration keeps the larger capacity, declaring while active warms at once
+    scene->DeclareComponent<Velocity>(10);
+    EXPECT_EQ(scene->GetPoolCapacity<Velocity>(), capacity);
+    EXPECT_EQ(scene->GetPoolCapacity<ExampleComponent>(), 0u);
+    scene->DeclareComponent<ExampleComponent>(64);
+    EXPECT_GE(scene->GetPoolCapacity<ExampleComponent>(), 64u);
+}
+
+// Teardown tests
+TEST_F(ECSTest, TeardownReleasesEveryEntityObject)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* level = Scene::Create<TestScene>(world, "Level");
+    Scene* menu = Scene::Create<TestScene>(world, "Menu");
+
+    sceneManager->SetBackgroundRelease(false);
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(level));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    for (int i{0}; i < 100; ++i) Entity::Create(level).WithName("Crate");
+    Entity* doomed = Entity::Create(level).WithName("Doomed");
+    Entity* sleeper = Entity::Create(level).WithName("Sleeper");
+    Entity::Create(level).WithName("Dreamer").WithParent(sleeper);
+    const Uuid sleeperUuid = sleeper->GetUuid();
+
+    // Destroyed entities await compaction and hibernated ones stay alive, so all are in the World
+    doomed->MarkForDestruction();
+    ASSERT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    ASSERT_TRUE(level->TryHibernate(sleeper));
+    EXPECT_EQ(world->GetCount<Entity>(), 103u);
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(menu));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    // Live, destroyed and hibernated entities all leave with the scene
+    EXPECT_EQ(world->GetCount<Entity>(), 0u);
+    EXPECT_EQ(world->TryGet<Entity>(sleeperUuid), nullptr);
+    EXPECT_EQ(level->GetEntityCount(), 0u);
+    EXPECT_EQ(level->GetHibernatedCount(), 0u);
+}
+
+// Background release tests
+TEST_F(ECSTest, OutgoingSceneReleasedInBackground)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* level = Scene::Create<TestScene>(world, "Level");
+    Scene* menu = Scene::Create<MainScene>(world, "Menu");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(level));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    for (int i{0}; i < 1000; ++i)
+    {
+        Entity* entity = Entity::Create(level).WithPos(Vec3::RIGHT * static_cast<float>(i));
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Velocity>(velocity));
+    }
+    ASSERT_GE(world->GetCount<Entity>(), 1000u);
+
+    ASSERT_TRUE(sceneManager->IsBackgroundReleaseEnabled());
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(menu));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+    EXPECT_EQ(sceneManager->GetCurrentScene(), menu);
+
+    // Entity objects leave the World during the transition, only their memory is released later
+    sceneManager->FlushReleases();
+    EXPECT_EQ(sceneManager->GetPendingReleaseCount(), 0u);
+    EXPECT_EQ(world->GetCount<Entity>(), menu->GetEntityCount());
+    EXPECT_EQ(level->GetEntityCount(), 0u);
+}
+
+TEST_F(ECSTest, MainThreadPoolsDestroyedBeforeHandoff)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* level = Scene::Create<TestScene>(world, "Level");
+    Scene* menu = Scene::Create<TestScene>(world, "Menu");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(level));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    for (int i{0}; i < 100; ++i)
+    {
+        Entity* entity = Entity::Create(level).WithName("Mesh");
+        GpuHandle* gpuHandle{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<GpuHandle>(gpuHandle));
+    }
+    gpuHandlesDestroyed = 0;
+    gpuHandleDestroyedOffFrameThread = false;
+
+    ASSERT_TRUE(sceneManager->IsBackgroundReleaseEnabled());
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(menu));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    // Opted-in pools are destroyed during the transition, before the releaser gets the scene
+    EXPECT_EQ(gpuHandlesDestroyed.load(), 100u);
+    sceneManager->FlushReleases();
+    EXPECT_EQ(gpuHandlesDestroyed.load(), 100u);
+    EXPECT_FALSE(gpuHandleDestroyedOffFrameThread.load());
+}
+
+// Compaction tests
+TEST_F(ECSTest, CompactionPolicySparesDeclaredPools)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    scene->DeclareComponent<ExampleComponent>(10000);
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    CompactionPolicy policy;
+    policy.enabled = true;
+    policy.minCapacity = 64;
+    scene->SetCompactionPolicy(policy);
+
+    std::vector<Entity*> movers;
+    for (int i{0}; i < 4096; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithName("Mover");
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Velocity>(velocity));
+        movers.push_back(entity);
+    }
+    const size_t declaredCapacity = scene->GetPoolCapacity<ExampleComponent>();
+    ASSERT_GE(declaredCapacity, 10000u);
+
+    // The empty declared pool is not underused, so cleanup leaves the destroyed entity for later
+    movers[0]->MarkForDestruction();
+    ASSERT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    EXPECT_EQ(world->GetCount<Entity>(), 4096u);
+
+    // Most movers gone leaves the other pools underused, so cleanup compacts on its own
+    for (size_t i{1}; i < 3500; ++i) movers[i]->MarkForDestruction();
+    ASSERT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    EXPECT_EQ(world->GetCount<Entity>(), 596u);
+    EXPECT_LT(scene->GetPoolCapacity<Velocity>(), 4096u);
+    EXPECT_EQ(scene->GetPoolCapacity<ExampleComponent>(), declaredCapacity);
+
+    // Compacting by hand again finds nothing left to release
+    const CompactionReport report = scene->Compact();
+    EXPECT_EQ(report.entitiesReleased, 0u);
+    EXPECT_EQ(report.tombstonesRemoved, 0u);
+    EXPECT_EQ(scene->GetPoolCapacity<ExampleComponent>(), declaredCapacity);
+    EXPECT_EQ(scene->GetEntityCount(), 596u);
+}
+
+// Bulk operation tests
+TEST_F(ECSTest, BulkOperationsCoverSpansAndQueries)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    std::vector<Entity*> entities;
+    for (int i{0}; i < 10; ++i) entities.push_back(Entity::Create(scene));
+    const std::vector<Entity*> tagged(entities.begin(), entities.begin() + 4);
+
+    EXPECT_EQ(scene->AddTags<ExampleTag>(tagged), 4u);
+    EXPECT_EQ(scene->AddTags<ExampleTag>(tagged), 0u);
+
+    Velocity fast;
+    fast.vel = Vec3::ONE;
+    EXPECT_EQ(scene->AddComponentsWhere<Velocity, ExampleTag>(fast), 4u);
+    EXPECT_EQ(scene->AddComponents<Velocity>(entities), 6u);
+
+    const Velocity* velocity{nullptr};
+    ASSERT_TRUE(entities[0]->TryGetComponent<Velocity>(velocity));
+    EXPECT_EQ(velocity->vel, Vec3::ONE);
+    EXPECT_EQ(velocity->GetOwner(), entities[0]);
+    ASSERT_TRUE(entities[9]->TryGetComponent<Velocity>(velocity));
+    EXPECT_EQ(velocity->GetOwner(), entities[9]);
+
+    Velocity stopped;
+    EXPECT_EQ(scene->ReplaceComponentsWhere<Velocity, ExampleTag>(stopped), 4u);
+    ASSERT_TRUE(entities[0]->TryGetComponent<Velocity>(velocity));
+    EXPECT_EQ(velocity->vel, Vec3::ZERO);
+    EXPECT_EQ(velocity->GetOwner(), entities[0]);
+
+    EXPECT_EQ(scene->RemoveComponentsWhere<Velocity, ExampleTag>(), 4u);
+    EXPECT_FALSE(entities[0]->HasComponent<Velocity>());
+    EXPECT_EQ(scene->RemoveComponents<Velocity>(entities), 6u);
+    EXPECT_EQ(scene->RemoveComponentsWhere<ExampleTag>(), 4u);
+}
+
+// Fused system tests
+TEST_F(ECSTest, FusedSystemRunsStagesInOrderPerEntity)
+{
+    using Pipeline = FusedSystem<QuerySignature<Velocity, ExampleTag>, RecordStage<1>, RecordStage<2>, RecordStage<3>>;
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    std::vector<Entity*> tagged;
+    for (int i{0}; i < 8; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithName("Mover");
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Velocity>(velocity));
+
+        // The tag filters the query without being passed to the stages
+        if (i % 2 == 1) continue;
+        ASSERT_TRUE(entity->TryAddTag<ExampleTag>());
+        tagged.push_back(entity);
+    }
+
+    ASSERT_TRUE(scene->TryAddSystem<Pipeline>(SystemPhase::Process));
+    fusedCalls.clear();
+    ASSERT_TRUE(sceneManager->Internal_TryProcess(nullptr));
+
+    // Every stage runs on an entity before the next entity starts
+    ASSERT_EQ(fusedCalls.size(), tagged.size() * 3);
+    for (size_t i{0}; i < fusedCalls.size(); i += 3)
+    {
+        EXPECT_NE(std::find(tagged.begin(), tagged.end(), fusedCalls[i].first), tagged.end());
+        for (int stage{0}; stage < 3; ++stage)
+        {
+            EXPECT_EQ(fusedCalls[i + stage].first, fusedCalls[i].first);
+            EXPECT_EQ(fusedCalls[i + stage].second, stage + 1);
+        }
+    }
+    for (Entity* const entity : tagged)
+    {
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryGetComponent<Velocity>(velocity));
+        EXPECT_EQ(velocity->vel, Vec3::RIGHT * 123.0f);
+    }
+}
+
+// Query tests
+TEST_F(ECSTest, PrefetchedQueryVisitsEveryMatchOnce)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    // Scatter the second pool so matches are not contiguous, and overflow the prefetch ring
+    const int count = static_cast<int>(Scene::QUERY_PREFETCH_DISTANCE) * 5 + 3;
+    std::unordered_map<Entity*, float> expected;
+    for (int i{0}; i < count * 3; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithPos(Vec3::RIGHT * static_cast<float>(i));
+        if (i % 3 != 0) continue;
+
+        Velocity* velocity{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Velocity>(velocity));
+        velocity->vel = Vec3::RIGHT * static_cast<float>(i);
+        expected.emplace(entity, static_cast<float>(i));
+    }
+
+    std::unordered_map<Entity*, int> visits;
+    scene->Query<Transform, Velocity>([&](Entity* entity, Transform& transform, Velocity& velocity) {
+        ++visits[entity];
+        EXPECT_EQ(transform.GetPos().x, expected.at(entity));
+        EXPECT_EQ(velocity.vel.x, expected.at(entity));
+    });
+
+    EXPECT_EQ(visits.size(), expected.size());
+    for (const auto& [entity, visitCount] : visits) EXPECT_EQ(visitCount, 1) << entity->GetName();
+
+    // Removing a queried component from the current entity is as safe as with a plain view
+    size_t removed{0};
+    scene->Query<Transform, Velocity>([&](Entity* entity, Transform& transform, Velocity& velocity) {
+        EXPECT_EQ(velocity.vel.x, transform.GetPos().x);
+        EXPECT_TRUE(entity->TryRemoveComponent<Velocity>());
+        ++removed;
+    });
+    EXPECT_EQ(removed, expected.size());
+
+    size_t remaining{0};
+    scene->Query<Transform, Velocity>([&remaining](Entity*, Transform&, Velocity&) { ++remaining; });
+    EXPECT_EQ(remaining, 0u);
+}
+
+TEST_F(ECSTest, SortedQueryRepairsOrderThroughEveryPath)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    const size_t count = 64;
+    std::vector<Entity*> entities;
+    for (size_t i{0}; i < count; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithName("Layer");
+        Depth* depth{nullptr};
+        ASSERT_TRUE(entity->TryAddComponent<Depth>(depth));
+        depth->z = static_cast<float>((i * 37) % count); // Pool order differs from key order
+        entities.push_back(entity);
+    }
+
+    SortedQuery<Depth, ByDepth> sorted(scene);
+    EXPECT_EQ(sorted.GetFullSortCount(), 1u);
+
+    const auto setDepth = [&sorted](Entity* entity, const float z) {
+        Depth* depth{nullptr};
+        ASSERT_TRUE(entity->TryGetComponent<Depth>(depth));
+        depth->z = z;
+        sorted.MarkDirty(entity);
+    };
+    // Visits in order and checks the keys against the order of the entities themselves
+    const auto expectSorted = [&sorted, &entities]() {
+        std::vector<Entity*> expected;
+        for (Entity* const entity : entities)
+        {
+            Depth* depth{nullptr};
+            if (entity->TryGetComponent<Depth>(depth)) expected.push_back(entity);
+        }
+        std::sort(expected.begin(), expected.end(), [](Entity* lhs, Entity* rhs) {
+            Depth* lhsDepth{nullptr};
+            Depth* rhsDepth{nullptr};
+            lhs->TryGetComponent<Depth>(lhsDepth);
+            rhs->TryGetComponent<Depth>(rhsDepth);
+            return lhsDepth->z < rhsDepth->z;
+        });
+
+        std::vector<Entity*> visited;
+        sorted.Each([&visited](Entity* entity, Depth&) { visited.push_back(entity); });
+        EXPECT_EQ(visited, expected);
+    };
+
+    // A few changes, an addition and a removal are merged back in
+    setDepth(entities[3], -1.0f);
+    setDepth(entities[10], 100.0f);
+    Entity* added = Entity::Create(scene).WithName("Added");
+    Depth* addedDepth{nullptr};
+    ASSERT_TRUE(added->TryAddComponent<Depth>(addedDepth));
+    addedDepth->z = 31.5f;
+    entities.push_back(added);
+    ASSERT_TRUE(entities[20]->TryRemoveComponent<Depth>());
+    expectSorted();
+    EXPECT_EQ(sorted.GetMergeCount(), 1u);
+    EXPECT_EQ(sorted.GetInsertionSortCount(), 0u);
+    EXPECT_EQ(sorted.GetFullSortCount(), 1u);
+
+    // Every key drifting a little, swapping neighbours, is insertion sorted within budget
+    for (Entity* const entity : entities)
+    {
+        Depth* depth{nullptr};
+        if (!entity->TryGetComponent<Depth>(depth)) continue;
+        setDepth(entity, depth->z + (static_cast<int>(depth->z) % 2 == 0 ? 1.25f : -1.25f));
+    }
+    expectSorted();
+    EXPECT_EQ(sorted.GetMergeCount(), 1u);
+    EXPECT_EQ(sorted.GetInsertionSortCount(), 1u);
+    EXPECT_EQ(sorted.GetFullSortCount(), 1u);
+
+    // Reversing every key spends the insertion budget and falls back to a full sort
+    for (Entity* const entity : entities)
+    {
+        Depth* depth{nullptr};
+        if (!entity->TryGetComponent<Depth>(depth)) continue;
+        setDepth(entity, -depth->z);
+    }
+    expectSorted();
+    EXPECT_EQ(sorted.GetMergeCount(), 1u);
+    EXPECT_EQ(sorted.GetInsertionSortCount(), 1u);
+    EXPECT_EQ(sorted.GetFullSortCount(), 2u);
+}
+
+TEST_F(ECSTest, PropagateTransformsCoversEveryDirtySubtree)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    // Roots with chains of different lengths so the work items are unbalanced
+    std::vector<Entity*> roots;
+    std::vector<Entity*> leaves;
+    size_t transformCount = 0;
+    for (int i{0}; i < 6; ++i)
+    {
+        Entity* root = Entity::Create(scene).WithName("Root " + std::to_string(i));
+        Entity* leaf = root;
+        for (int depth{0}; depth < i; ++depth) leaf = Entity::Create(scene).WithParent(leaf);
+        roots.push_back(root);
+        leaves.push_back(leaf);
+        transformCount += static_cast<size_t>(i) + 1;
+    }
+
+    EXPECT_EQ(scene->PropagateTransforms(), transformCount) << "New transforms start dirty";
+    EXPECT_EQ(scene->PropagateTransforms(), 0u) << "Nothing moved since the last pass";
+
+    // Pulling one world matrix lazily cleans its ancestors, the rest of the chain stays dirty
+    roots[5]->GetTransform().SetPos(Vec3::RIGHT);
+    roots[2]->GetTransform().SetPos(Vec3::RIGHT);
+    roots[5]->GetTransform().GetChildren().front()->GetTransform().GetWorldMatrix();
+    EXPECT_EQ(scene->PropagateTransforms(), 4u + 3u);
+
+#if VELECS_ECS_STATS_ENABLED
+    scene->ResetStats();
+    for (Entity* leaf : leaves) leaf->GetTransform().GetWorldMatrix();
+    EXPECT_EQ(scene->GetStats().worldRecomputes, 0u) << "Every world matrix should already be cached";
+#endif
+}
+
+TEST_F(ECSTest, AffineMatchesMat4Math)
+{
+    const auto expectNear = [](Mat4 actual, Mat4 expected) {
+        for (int col{0}; col < 4; ++col)
+        {
+            for (int row{0}; row < 4; ++row)
+            {
+                EXPECT_NEAR(actual[col][row], expected[col][row], 1e-4f) << "column " << col << ", row " << row;
+            }
+        }
+    };
+    const auto composeTRS = [](const Vec3& pos, const Quat& rot, const Vec3& scale) {
+        return Mat4::FromPosition(pos) * rot.ToMatrix() * Mat4::FromScale(scale);
+    };
+
+    const Vec3 parentPos{1.0f, -2.0f, 3.5f};
+    const Quat parentRot = Quat::FromEulerAnglesDeg(Vec3{30.0f, 45.0f, -60.0f});
+    const Vec3 parentScale{2.0f, 0.5f, 1.5f};
+    const Vec3 childPos{-4.0f, 0.25f, 2.0f};
+    const Quat childRot = Quat::FromEulerAnglesDeg(Vec3{-15.0f, 90.0f, 10.0f});
+    const Vec3 childScale{1.0f, 3.0f, 0.75f};
+
+    const Affine3x4 parent = Affine3x4::FromTRS(parentPos, parentRot, parentScale);
+    const Affine3x4 child = Affine3x4::FromTRS(childPos, childRot, childScale);
+    expectNear(parent.ToMat4(), composeTRS(parentPos, parentRot, parentScale));
+    expectNear(child.ToMat4(), composeTRS(childPos, childRot, childScale));
+
+    // Composition must agree with the full 4x4 product, implied bottom row included
+    expectNear((parent * child).ToMat4(), composeTRS(parentPos, parentRot, parentScale) * composeTRS(childPos, childRot, childScale));
+    expectNear((parent * parent.Inverse()).ToMat4(), Mat4::IDENTITY);
+}
+
+TEST_F(ECSTest, RotationKernelsMatchQuatMath)
+{
+    // Reference math, one quaternion at a time
+    const auto quat = [](const float x, const float y, const float z, const float w) {
+        Quat q;
+        q.x = x;
+        q.y = y;
+        q.z = z;
+        q.w = w;
+        return q;
+    };
+    const auto normalized = [&quat](const Quat& q) {
+        const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        return quat(q.x / length, q.y / length, q.z / length, q.w / length);
+    };
+    const auto integrated = [&quat, &normalized](const Quat& q, const Vec3& omega, const float deltaTime) {
+        // q + dt / 2 * (omega * q), with omega the pure quaternion (x, y, z, 0)
+        const float h = 0.5f * deltaTime;
+        return normalized(quat(q.x + h * (omega.x * q.w + omega.y * q.z - omega.z * q.y),
+                               q.y + h * (omega.y * q.w - omega.x * q.z + omega.z * q.x),
+                               q.z + h * (omega.x * q.y - omega.y * q.x + omega.z * q.w),
+                               q.w - h * (omega.x * q.x + omega.y * q.y + omega.z * q.z)));
+    };
+    const auto slerped = [&quat, &normalized](const Quat& from, Quat to, const float t) {
+        float dot = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+        if (dot < 0.0f)
+        {
+            to = quat(-to.x, -to.y, -to.z, -to.w);
+            dot = -dot;
+        }
+        const float angle = std::acos(std::min(dot, 1.0f));
+        const float a = std::sin((1.0f - t) * angle) / std::sin(angle);
+        const float b = std::sin(t * angle) / std::sin(angle);
+        return normalized(quat(a * from.x + b * to.x, a * from.y + b * to.y, a * from.z + b * to.z, a * from.w + b * to.w));
+    };
+    const auto expectNear = [](const Quat& actual, const Quat& expected, const std::string& label) {
+        EXPECT_NEAR(actual.x, expected.x, 1e-5f) << label;
+        EXPECT_NEAR(actual.y, expected.y, 1e-5f) << label;
+        EXPECT_NEAR(actual.z, expected.z, 1e-5f) << label;
+        EXPECT_NEAR(actual.w, expected.w, 1e-5f) << label;
+    };
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    // Six lanes, so the kernels cover one full group of four and one padded group
+    std::vector<Transform*> transforms;
+    for (int i{0}; i < 6; ++i)
+    {
+        Entity* entity = Entity::Create(scene).WithName("Spinner");
+        transforms.push_back(&entity->GetTransform());
+    }
+    const std::vector<Quat> starts{
+        Quat::FromEulerAnglesDeg(Vec3{10.0f, 20.0f, 30.0f}),
+        Quat::FromEulerAnglesDeg(Vec3{-45.0f, 90.0f, 0.0f}),
+        Quat::FromEulerAnglesDeg(Vec3{0.0f, 0.0f, 170.0f}),
+        Quat::FromEulerAnglesDeg(Vec3{60.0f, -30.0f, 15.0f}),
+        Quat::FromEulerAnglesDeg(Vec3{5.0f, 5.0f, 5.0f}),
+        Quat::FromEulerAnglesDeg(Vec3{-120.0f, 10.0f, 80.0f}),
+    };
+
+    for (const bool simd : {true, false})
+    {
+        const std::string path = simd ? "SSE path, lane " : "Scalar path, lane ";
+
+        // Normalize: drifted lanes are rescaled, the rest keep their exact value
+        const std::vector<float> scales{1.5f, 1.0f, 0.0f, 0.7f, 1.00001f, 2.0f};
+        std::vector<Quat> before;
+        RotationBatch batch;
+        batch.SetSimdEnabled(simd);
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            const Quat& q = starts[i];
+            before.push_back(quat(q.x * scales[i], q.y * scales[i], q.z * scales[i], q.w * scales[i]));
+            transforms[i]->SetRot(before.back());
+            batch.Add(transforms[i]);
+        }
+        batch.Normalize();
+        EXPECT_EQ(batch.Apply(), 3u) << path;
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            const bool drifted = i == 0 || i == 3 || i == 5;
+            expectNear(transforms[i]->GetRot(), drifted ? normalized(before[i]) : before[i], path + std::to_string(i));
+        }
+
+        // Integrate: lanes without angular velocity are left alone
+        const std::vector<Vec3> spins{Vec3{1.0f, 0.0f, 0.0f}, Vec3{0.0f, 0.0f, 0.0f}, Vec3{0.5f, -2.0f, 1.0f},
+                                      Vec3{0.0f, 3.0f, 0.0f}, Vec3{-1.0f, 1.0f, 0.25f}, Vec3{0.0f, 0.0f, 0.0f}};
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            transforms[i]->SetRot(starts[i]);
+            batch.Add(transforms[i], spins[i]);
+        }
+        batch.Integrate(0.016f);
+        EXPECT_EQ(batch.Apply(), 4u) << path;
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            const bool spinning = i != 1 && i != 5;
+            expectNear(transforms[i]->GetRot(), spinning ? integrated(starts[i], spins[i], 0.016f) : starts[i], path + std::to_string(i));
+        }
+
+        // Slerp: a zero step, a target equal to the rotation or to its negation change nothing
+        const Quat goal = Quat::FromEulerAnglesDeg(Vec3{0.0f, 45.0f, 0.0f});
+        std::vector<Quat> targets(transforms.size(), goal);
+        targets[1] = starts[1];
+        targets[4] = quat(-starts[4].x, -starts[4].y, -starts[4].z, -starts[4].w);
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            transforms[i]->SetRot(starts[i]);
+            batch.Add(transforms[i], targets[i]);
+        }
+        batch.Slerp(0.0f);
+        EXPECT_EQ(batch.Apply(), 0u) << path;
+
+        for (size_t i{0}; i < transforms.size(); ++i) batch.Add(transforms[i], targets[i]);
+        batch.Slerp(0.25f);
+        EXPECT_EQ(batch.Apply(), 4u) << path;
+        for (size_t i{0}; i < transforms.size(); ++i)
+        {
+            const bool moving = i != 1 && i != 4;
+            expectNear(transforms[i]->GetRot(), moving ? slerped(starts[i], goal, 0.25f) : starts[i], path + std::to_string(i));
+        }
+    }
+}
+
+TEST_F(ECSTest, SpaceConversionsRoundTripAndFollowParent)
+{
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Entity* parent = Entity::Create(scene).WithPos(Vec3::RIGHT * 4.0f).WithEulerAnglesDeg(Vec3{0.0f, 90.0f, 0.0f});
+    Entity* child = Entity::Create(scene).WithPos(Vec3::ONE).WithScale(Vec3::ONE * 2.0f).WithParent(parent);
+    Transform& transform = child->GetTransform();
+
+    std::vector<Vec3> points{Vec3::ZERO, Vec3::RIGHT, Vec3{1.0f, -2.0f, 3.0f}};
+    std::vector<Vec3> converted(points.size());
+    transform.TransformPoints(points.data(), converted.data(), points.size());
+    transform.InverseTransformPoints(converted.data(), converted.data(), converted.size());
+    for (size_t i{0}; i < points.size(); ++i)
+    {
+        EXPECT_NEAR(converted[i].x, points[i].x, 1e-4f);
+        EXPECT_NEAR(converted[i].y, points[i].y, 1e-4f);
+        EXPECT_NEAR(converted[i].z, points[i].z, 1e-4f);
+    }
+
+    // The cached inverse must follow the parent
+    const Vec3 worldOrigin = transform.TransformPoint(Vec3::ZERO);
+    parent->GetTransform().SetPos(parent->GetTransform().GetPos() + Vec3::RIGHT);
+    const Vec3 local = transform.InverseTransformPoint(worldOrigin + Vec3::RIGHT);
+    EXPECT_NEAR(local.x, 0.0f, 1e-4f);
+    EXPECT_NEAR(local.y, 0.0f, 1e-4f);
+    EXPECT_NEAR(local.z, 0.0f, 1e-4f);
+}
+
+TEST_F(ECSTest, RelationsIndexBothWaysAndReleaseOnDestroy)
+{
+    struct Targets {};
+    struct Owns {};
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Entity* player = Entity::Create(scene).WithName("Player");
+    Entity* turret = Entity::Create(scene).WithName("Turret");
+    Entity* drone = Entity::Create(scene).WithName("Drone");
+
+    EXPECT_TRUE(scene->TryAddRelation<Targets>(turret, player));
+    EXPECT_TRUE(scene->TryAddRelation<Targets>(drone, player));
+    EXPECT_FALSE(scene->TryAddRelation<Targets>(drone, player)) << "Duplicate relations should be rejected";
+    EXPECT_TRUE(scene->TryAddRelation<Owns>(player, drone));
+
+    EXPECT_TRUE(scene->HasRelation<Targets>(turret, player));
+    EXPECT_FALSE(scene->HasRelation<Targets>(player, turret)) << "Relations are directed";
+    EXPECT_FALSE(scene->HasRelation<Owns>(turret, player)) << "Kinds are indexed separately";
+
+    std::vector<Entity*> attackers;
+    scene->ForEachRelationSource<Targets>(player, [&attackers](Entity* source) { attackers.push_back(source); });
+    EXPECT_EQ(attackers.size(), 2u);
+    EXPECT_NE(std::find(attackers.begin(), attackers.end(), turret), attackers.end());
+    EXPECT_NE(std::find(attackers.begin(), attackers.end(), drone), attackers.end());
+
+    // Destroying the drone drops its relations of every kind, in both directions
+    const size_t entityCount = scene->GetEntityCount();
+    drone->MarkForDestruction();
+    ASSERT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    EXPECT_EQ(scene->GetEntityCount(), entityCount - 1) << "Entities awaiting compaction must not be counted";
+    EXPECT_EQ(scene->GetRelationSourceCount<Targets>(player), 1u);
+    EXPECT_EQ(scene->GetRelationTargetCount<Owns>(player), 0u);
+
+    EXPECT_TRUE(scene->TryRemoveRelation<Targets>(turret, player));
+    EXPECT_EQ(scene->GetRelationSourceCount<Targets>(player), 0u);
+}
+
+TEST_F(ECSTest, CachedQueryFollowsStructuralChanges)
+{
+    struct Targets {};
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    Entity* player = Entity::Create(scene).WithName("Player");
+    std::vector<Entity*> units;
+    for (int i = 0; i < 4; ++i)
+    {
+        Entity* unit = Entity::Create(scene).WithName("Unit");
+        Velocity* velocity = nullptr;
+        ASSERT_TRUE(unit->TryAddComponent<Velocity>(velocity));
+        units.push_back(unit);
+    }
+    ASSERT_TRUE(units[3]->TryAddTag<ExampleTag>());
+    ASSERT_TRUE(scene->TryAddRelation<Targets>(units[0], player));
+    ASSERT_TRUE(scene->TryAddRelation<Targets>(units[1], player));
+    ASSERT_TRUE(scene->TryAddRelation<Targets>(units[3], player));
+
+    auto* attackers = scene->CreateCachedQuery<QuerySignature<Velocity>, Exclude<ExampleTag>>(
+        [scene, player](Entity* entity) { return scene->HasRelation<Targets>(entity, player); });
+    EXPECT_EQ(attackers->GetCount(), 2u) << "Unit 3 is excluded and unit 2 fails the filter";
+
+    // Pool changes are picked up on the next iteration
+    ASSERT_TRUE(units[3]->TryRemoveTag<ExampleTag>());
+    ASSERT_TRUE(units[0]->TryRemoveComponent<Velocity>());
+    std::vector<Entity*> visited;
+    attackers->Each([&visited](Entity* entity) { visited.push_back(entity); });
+    EXPECT_EQ(visited.size(), 2u);
+    EXPECT_NE(std::find(visited.begin(), visited.end(), units[1]), visited.end());
+    EXPECT_NE(std::find(visited.begin(), visited.end(), units[3]), visited.end());
+
+    // Relations fire no pool signal, so they are reported explicitly
+    ASSERT_TRUE(scene->TryAddRelation<Targets>(units[2], player));
+    attackers->Reevaluate(units[2]);
+    EXPECT_EQ(attackers->GetEntities().size(), 3u);
+
+    units[1]->MarkForDestruction();
+    ASSERT_TRUE(sceneManager->Internal_TryProcessEntityCleanup());
+    EXPECT_EQ(attackers->GetEntities().size(), 2u);
+
+    EXPECT_TRUE(scene->TryDestroyCachedQuery(attackers));
+    EXPECT_EQ(scene->GetCachedQueryCount(), 0u);
+}
+
+TEST_F(ECSTest, EventChannelsDeliverLastFramesEvents)
+{
+    struct DamageDealt { int amount; };
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    EventChannel<DamageDealt>& damage = scene->GetEventChannel<DamageDealt>();
+    EXPECT_EQ(&damage, &scene->GetEventChannel<DamageDealt>());
+
+    // Pool tasks send concurrently, each into its own buffer
+    world->workers->ParallelFor(64, [&damage](const size_t i) { damage.Send(DamageDealt{static_cast<int>(i)}); });
+    damage.Emplace(DamageDealt{1000});
+    EXPECT_TRUE(damage.IsEmpty()) << "Events must not be readable in the frame they are sent";
+
+    ASSERT_TRUE(sceneManager->Internal_TryProcess(nullptr));
+    EXPECT_EQ(damage.GetCount(), 65u);
+
+    int total = 0;
+    damage.Each([&total](const DamageDealt& event) { total += event.amount; });
+    EXPECT_EQ(total, 63 * 64 / 2 + 1000);
+
+    size_t batched = 0;
+    damage.EachBatch([&batched](const DamageDealt*, const size_t count) { batched += count; });
+    EXPECT_EQ(batched, 65u);
+
+    // Events are read for one frame only
+    ASSERT_TRUE(sceneManager->Internal_TryProcess(nullptr));
+    EXPECT_TRUE(damage.IsEmpty());
+}
+
+TEST_F(ECSTest, EventChannelsTakeSendsFromAnyThread)
+{
+    struct Ping { int value; };
+
+    auto world = GetWorld();
+    auto sceneManager = world->scenes.get();
+    Scene* scene = Scene::Create<TestScene>(world, "Test Scene");
+
+    ASSERT_TRUE(sceneManager->TryRequestSceneTransition(scene));
+    ASSERT_TRUE(sceneManager->Internal_TryTransitionIfRequested(nullptr));
+
+    EventChannel<Ping>& pings = scene->GetEventChannel<Ping>();
+
+    // A streaming thread and another world's pool, with more workers than this one, send while
+    // this pool's tasks and the frame thread do
+    const int outsideCount = 2000;
+    std::atomic<bool> go{false};
+    std::thread streamer([&pings, &go]() {
+        while (!go.load()) std::this_thread::yield();
+        for (int i{0}; i < outsideCount; ++i) pings.Send(Ping{1});
+    });
+    WorkerPool otherPool(world->workers->GetThreadCount() + 4);
+    std::thread otherFrame([&pings, &otherPool, &go]() {
+        while (!go.load()) std::this_thread::yield();
+        otherPool.ParallelFor(outsideCount, [&pings](const size_t) { pings.Emplace(Ping{10}); });
+    });
+
+    go = true;
+    world->workers->ParallelFor(outsideCount, [&pings](const size_t) { pings.Send(Ping{100}); });
+    for (int i{0}; i < outsideCount; ++i) pings.Emplace(Ping{1000});
+    streamer.join();
+    otherFrame.join();
+
+    ASSERT_TRUE(sceneManager->Internal_TryProcess(nullptr));
+    EXPECT_EQ(pings.GetCount(), static_cast<size_t>(4 * outsideCount));
+
+    int total = 0;
+    pings.Each([&total](const Ping& ping) { total += ping.value; });
+    EXPECT_EQ(total, outsideCount * 1111);
+
+    // The frame thread's own events stay together in its batch, never in the shared one
+    std::vector<size_t> frameEventsPerBatch;
+    pings.EachBatch([&frameEventsPerBatch](const Ping* batch, const size_t count) {
+        frameEventsPerBatch.push_back(std::count_if(batch, batch + count, [](const Ping& ping) { return ping.value == 1000; }));
+    });
+    EXPECT_EQ(std::count(frameEventsPerBatch.begin(), frameEventsPerBatch.end(), static_cast<size_t>(outsideCount)), 1);
+}
+
 // Transform tests
 // TEST_F(ECSTest, TransformBasics)
 // {